@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 07:16:17 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 23:00:28 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -16,24 +16,59 @@
 # include "types_bonus.h"
 
 t_world		new_world(void);
-t_object	*new_object(t_obj_type type, t_shapes shape);
-void		ft_add_object(t_object **lst, t_object *new);
-t_light		*new_light(t_tuple point, t_tuple color);
-void		ft_add_light(t_light **lst, t_light *new);
+t_object	*new_object(t_arena *arena, t_obj_type type, t_shapes shape);
+t_material	*object_material(t_object *obj);
+void		object_transforms(t_object *obj, t_matrix **trans, t_matrix **inv);
+void		ft_add_object(t_object **lst, t_object **last, t_object *new);
+t_light		*new_light(t_arena *arena, t_tuple point, t_tuple color);
+void		ft_add_light(t_light **lst, t_light **last, t_light *new);
 t_inters	*intersect_world(t_world world, t_ray ray);
 bool		intersect_world_shadow(t_world world, t_ray ray, float max_distance);
-t_comps		*prepare_computations(t_inters *intersection, t_ray ray, \
-			t_inters *intersections);
+bool		blocks_shadow_ray(t_object *obj, t_ray ray, float max_distance, \
+			t_ray_stats *stats);
+bool		intersect_occluders(t_object **occluders, t_ray ray, \
+			float max_distance, t_ray_stats *stats);
+void		prepare_computations(t_inters *intersection, t_ray ray, \
+			t_inters *intersections, t_comps *comps);
+t_tuple		comps_local_point(t_comps *comp);
 t_camera	camera(double hsize, double vsize, double field_of_view);
 t_matrix	view_transformation(t_tuple from, t_tuple to, t_tuple up);
 t_ray		ray_for_pixel(t_camera cam, double px, double py);
 bool		is_shadowed(t_world world, t_tuple point, t_light *light);
-t_tuple		shade_hit(t_world world, t_comps *comp, int depth);
-t_tuple		color_at(t_world world, t_ray ray, int depth);
-t_tuple		reflected_color(t_world world, t_comps *comps, int depth);
-t_tuple		refracted_color(t_world world, t_comps *comps, int depth);
+bool		shadowed_from(t_world world, t_tuple point, t_tuple target, \
+			t_light *light);
+t_tuple		shade_surface(t_world *world, t_comps *comp);
+t_tuple		shade_light(t_world *world, t_comps *comp, t_light *light, \
+			float scale);
+bool		shade_next_bounce(t_world *world, t_trace_frame *frame, \
+			t_bounce *next);
+t_tuple		shade_blend(t_trace_frame *frame);
+t_tuple		color_at(t_world world, t_ray ray, int depth, float weight);
+bool		first_hit(t_world *world, t_ray ray, t_comps *comps);
+t_tuple		color_from_hit(t_world world, t_comps *comps, int depth, \
+			float weight);
+bool		reflected_ray(t_world *world, t_comps *comps, int depth, \
+			float weight, t_bounce *out);
+bool		refracted_ray(t_world *world, t_comps *comps, int depth, \
+			float weight, t_bounce *out);
 void		compute_n1_n2(t_inters *hit, t_inters *xs, t_comps *comps);
+bool		path_below_threshold(t_world *world, float weight);
+float		path_survival(t_world *world, t_ray ray, int depth, float weight);
 
+// Bounce limit; also sizes the frame stack color_at keeps per call
 # define MAX_REFLECTION_DEPTH 5
+// Secondary rays whose throughput falls below one 8-bit colour step are cut
+# define MIN_RAY_WEIGHT 0.00392157f
+// Below this throughput, Russian roulette mode plays instead of cutting
+# define RR_WEIGHT 0.1f
+// Nesting depth of the fixed containment stack used by compute_n1_n2
+# define MAX_CONTAINERS 32
 t_sphere	glass_sphere(void);
+
+// Scene arena
+# define ARENA_CHUNK 1048576 // Bytes per arena block (1 MiB)
+# define ARENA_ALIGN 16 // Every arena allocation starts on this boundary
+
+void		*arena_alloc(t_arena *arena, size_t size);
+void		arena_free(t_arena *arena);
 #endif
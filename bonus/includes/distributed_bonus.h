@@ -0,0 +1,77 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   distributed_bonus.h                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:03:06 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 23:29:20 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef DISTRIBUTED_BONUS_H
+# define DISTRIBUTED_BONUS_H
+
+# include <sys/types.h>
+# include "types_bonus.h"
+
+typedef struct s_data	t_data;
+
+// Most worker connections a coordinator keeps at once
+# define MAX_WORKERS 64
+// Default seconds a worker gets to return a tile before it is reassigned
+# define TILE_TIMEOUT 30.0f
+// Poll interval of the coordinator loop, in milliseconds
+# define POLL_INTERVAL 100
+
+typedef enum e_tile_state
+{
+	TILE_PENDING,
+	TILE_ASSIGNED,
+	TILE_DONE
+}	t_tile_state;
+
+/*
+** fb points at data->fb, so a --checkpoint of a distributed render is the
+** same file a local render of the same job writes and resumes. ckpt is
+** that data while the checkpoint writer runs, NULL otherwise.
+*/
+typedef struct s_coordinator
+{
+	t_options		*opts;
+	char			*address;
+	char			*own_socket;
+	int				listen_fd;
+	t_peer			peers[MAX_WORKERS];
+	int				peer_count;
+	pid_t			children[MAX_WORKERS];
+	int				child_count;
+	unsigned char	*tiles;
+	t_tile			region;
+	int				total_tiles;
+	int				tiles_done;
+	int				cursor;
+	int				reassigned;
+	t_framebuffer	*fb;
+	t_data			*ckpt;
+}	t_coordinator;
+
+int		net_listen(char *address);
+int		net_connect(char *address);
+void	net_nodelay(int fd);
+bool	net_send(int fd, t_msg_type type, void *payload, uint32_t size);
+bool	net_write(int fd, void *buf, size_t size);
+bool	net_read(int fd, void *buf, size_t size);
+double	net_clock(void);
+
+int		run_worker(t_options *opts);
+int		run_coordinator(t_data *data);
+bool	accept_peer(t_coordinator *co);
+void	drop_peer(t_coordinator *co, int index, char *reason);
+bool	receive_from_peer(t_coordinator *co, int index);
+bool	coordinator_checkpoint_start(t_coordinator *co, t_data *data);
+void	coordinator_checkpoint_tile(t_coordinator *co, int index);
+void	coordinator_checkpoint_stop(t_coordinator *co);
+
+#endif
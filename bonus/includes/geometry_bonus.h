@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 09:01:42 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 09:46:38 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -19,6 +19,23 @@
 # define CONE_EPSILON 0.0001f
 # define PLANE_EPSILON 0.0001f
 
+# define BVH_BINS 16 // SAH split candidates per axis
+# define BVH_MAX_LEAF 8 // Larger nodes are always split
+# define BVH_MAX_DEPTH 48 // Deeper nodes stay leaves; bounds the stack
+# define BVH_STACK 64
+# define BVH_TRAVERSAL_COST 1.0f // Node visit vs one triangle test
+# define BVH_SLAB_PAD 1e-6f // Relative slack on a node's exit distance
+
+typedef struct s_bvh_stack
+{
+	int		node[BVH_STACK];
+	float	enter[BVH_STACK];
+	int		size;
+}	t_bvh_stack;
+
+// Called on each leaf a walk or query reaches; true stops it
+typedef bool	(*t_bvh_leaf)(void *ctx, const t_bvh_node *leaf);
+
 // Scale-adaptive epsilon: grows gently with distance
 // For t=1, returns ~0.0002; for t=100, returns ~0.01; for t=1000, returns ~0.1
 static inline float	adaptive_epsilon(float t)
@@ -35,6 +52,25 @@ static inline float	adaptive_epsilon(float t)
 	return (result);
 }
 
+/*
+** min/max for the BVH build and traversal loops. Unlike fminf and fmaxf
+** they ignore NaN rules, so the compiler inlines them instead of calling
+** libm on every box test.
+*/
+static inline float	bvh_min(float a, float b)
+{
+	if (a < b)
+		return (a);
+	return (b);
+}
+
+static inline float	bvh_max(float a, float b)
+{
+	if (a > b)
+		return (a);
+	return (b);
+}
+
 t_sphere	sphere(void);
 t_material	material(void);
 t_sphere	sp_transform(t_matrix m, t_sphere sp);
@@ -54,6 +90,12 @@ bool		intersect_cylinder(t_cylinder *cyl, t_ray ray, \
 			t_inters **intersections, t_object *obj);
 bool		intersect_cone(t_cone *cone, t_ray ray, \
 			t_inters **intersections, t_object *obj);
+bool		intersect_mesh(t_mesh *me, t_ray ray, t_inters **xs, t_object *obj);
+bool		mesh_occludes(t_mesh *me, t_ray ray, float max_distance);
+void		intersect_object(t_object *obj, t_ray ray, t_inters **xs);
+t_bounds	object_bounds(t_object *obj);
+t_bounds	transformed_bounds(t_matrix m, t_bounds b);
+bool		ray_hits_bounds(t_bounds *b, t_ray ray, float t_max);
 t_inters	*new_intersection(float t, t_object *obj);
 void		ft_add_intersection(t_inters **lst, t_inters *new);
 void		sort_intersections(t_inters **lst);
@@ -61,6 +103,32 @@ float		hit(t_inters *list);
 t_tuple		position(t_ray ray, float distance);
 t_ray		transform_ray(t_ray ray, t_matrix m);
 
+// Bounding Volume Hierarchies
+int			bvh_build(t_bvh_ref *refs, int count, t_bvh_node **nodes);
+t_bvh_ray	bvh_ray(t_ray ray, float t_min, float t_max);
+bool		bvh_hit_node(const t_bvh_node *n, const t_bvh_ray *r, \
+			float *t_near);
+bool		bvh_walk(const t_bvh_node *nodes, const t_bvh_ray *r, \
+			t_bvh_leaf visit, void *ctx);
+bool		bvh_query(const t_bvh_node *nodes, const float p[3], \
+			t_bvh_leaf visit, void *ctx);
+
+// Triangle Meshes
+bool		mesh_build_bvh(t_mesh_data *m);
+t_tuple		mesh_normal_at(t_mesh *me, t_inters *hit);
+t_tuple		mesh_uv_at(t_mesh *me, t_inters *hit);
+void		mesh_free(t_mesh_data *geo);
+
+// Instancing
+bool		instance_add(t_instances *set, t_proto *proto, t_matrix trans, \
+			t_matrix inv);
+bool		instances_build(t_instances *set);
+void		intersect_instances(t_instances *set, t_ray ray, t_inters **xs, \
+			t_ray_stats *stats);
+bool		instances_occlude(t_instances *set, t_ray ray, float max_distance, \
+			t_ray_stats *stats);
+t_tuple		instance_normal(t_instance *inst, t_tuple normal);
+
 // UV Mapping
 t_tuple		sphere_uv_mapping(t_tuple local_point);
 t_tuple		plane_uv_mapping(t_tuple local_point);
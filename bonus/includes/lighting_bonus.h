@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 07:16:17 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 17:14:04 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,9 +15,29 @@
 
 # include "types_bonus.h"
 
+# define SPECULAR_CUTOFF 8.3178f // ln(4096): lobes below 1/4096 are dropped
+
 t_light		point_light(t_tuple point, t_tuple color);
-t_tuple		lighting(t_material material, t_light light, t_tuple position, \
-			t_tuple eyev, t_tuple normalv, bool in_shadow, \
-			t_tuple ambient_color);
+t_tuple		lighting(const t_material *material, const t_light *light, \
+			const t_comps *comp, bool in_shadow);
+void		build_light_occluders(t_world *world, t_tuple eye);
+
+// Many lights
+# define MAX_LIGHT_SAMPLES 64 // Upper bound of --light-samples
+
+float		light_falloff(t_light *light, t_tuple point);
+float		light_peak(t_light *light);
+bool		build_light_tree(t_light_tree *tree, t_light *lights, \
+			float cutoff);
+void		free_light_tree(t_light_tree *tree);
+t_tuple		direct_lighting(t_world *world, t_comps *comp, t_tuple color);
+float		hash_random(t_tuple p, uint32_t salt);
+
+// Area lights
+# define AREA_GRID 4 // Penumbra rays: n x n strata, ordered in g_strata
+# define AREA_PROBES 4 // Rays cast first; the rest only if they disagree
+
+float		light_extent(t_light *light);
+float		light_visibility(t_world *world, t_tuple point, t_light *light);
 
 #endif
@@ -6,7 +6,7 @@
 /*   By: mac <mac@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2025/12/20 07:21:26 by mac              ###   ########.fr       */
+/*   Updated: 2026/10/19 16:09:07 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,21 +14,10 @@
 # define MATH_BONUS_H
 
 # include "types_bonus.h"
+# include "vector_simd_bonus.h"
 
 bool		f_equal(float a, float b);
 bool		tuple_comparison(t_tuple a, t_tuple b);
-t_tuple		add_tuple(t_tuple a, t_tuple b);
-t_tuple		substract_tuple(t_tuple a, t_tuple b);
-t_tuple		negate_tuple(t_tuple a);
-t_tuple		tuple_scalar_mult(t_tuple a, float scalar);
-t_tuple		tuple_scalar_divide(t_tuple a, float scalar);
-t_tuple		mult_tuple(t_tuple a, t_tuple b);
-float		vector_magnitude(t_tuple v);
-t_tuple		normalizing_vector(t_tuple v);
-float		vecs_dot_product(t_tuple va, t_tuple vb);
-t_tuple		vecs_cross_product(t_tuple va, t_tuple vb);
-t_tuple		hadamard_product(t_tuple a, t_tuple b);
-t_tuple		reflect(t_tuple in, t_tuple normal);
 bool		compare_matrix(t_matrix a, t_matrix b);
 t_matrix	multiply_matrix(t_matrix a, t_matrix b);
 t_tuple		multiply_matrix_by_tuple(t_matrix m, t_tuple v);
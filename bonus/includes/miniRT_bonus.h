@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/01 00:00:00 by amn700            #+#    #+#             */
-/*   Updated: 2026/01/03 07:26:01 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 21:26:39 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -37,18 +37,25 @@ typedef struct mlx_image mlx_image_t;
 # include "rendering_bonus.h"
 # include "utils_bonus.h"
 # include "texture_bonus.h"
+# include "distributed_bonus.h"
+# include "server_bonus.h"
+# include "profile_bonus.h"
 
 # define NUM_THREADS 8
 # define MODE_PREVIEW 1
 # define MODE_LOAD 2
+# define MIN_DRAG 4 // px; a shorter mouse drag is just a click
 
 t_pattern	stripe_patern(t_tuple a, t_tuple b);
 t_pattern	ring_pattern(t_tuple a, t_tuple b);
 t_pattern	checkers_pattern(t_tuple a, t_tuple b);
-t_tuple		stripe_at(t_pattern pattern, t_tuple point);
-t_tuple		ring_at(t_pattern pattern, t_tuple point);
-t_tuple		checkers_at(t_pattern pattern, t_tuple point);
+t_tuple		stripe_at(const t_pattern *pattern, t_tuple point);
+t_tuple		ring_at(const t_pattern *pattern, t_tuple point);
+t_tuple		checkers_at(const t_pattern *pattern, t_tuple point);
+t_tuple		pattern_color(const t_pattern *pattern, t_tuple local_point);
+void		pattern_colors(const t_pattern *pattern, t_pattern_run *run);
 
+int			setup_world(t_data *data, t_camera *cam);
 void		free_objects_and_lights(t_data *data);
 
 typedef enum e_state
@@ -62,32 +69,75 @@ typedef enum e_state
 typedef struct s_render_ctx
 {
 	mlx_image_t		*img;
+	t_framebuffer	*fb;
 	t_camera		cam;
 	t_world			world;
-	int				start_y;
-	int				end_y;
-	int				*lines_done;
+	int				samples;
+	t_gbuffer		*gbuf;
+	bool			relight;
+	t_heatmap		*heat;
+	t_tile			region;
+	int				total_tiles;
+	unsigned char	*tile_done;
+	int				*next_tile;
+	int				*tiles_done;
 	pthread_mutex_t	*mutex;
 	volatile int	*stop_flag;
 }	t_render_ctx;
 
+/*
+** Periodic snapshot of finished tiles to opts.checkpoint, written by its
+** own thread; key fingerprints the scene and job so --resume can refuse a
+** checkpoint made for something else.
+*/
+typedef struct s_checkpoint
+{
+	pthread_t		thread;
+	pthread_mutex_t	lock;
+	pthread_cond_t	wake;
+	bool			quit;
+	bool			running;
+	uint64_t		key;
+}	t_checkpoint;
+
 typedef struct s_data
 {
+	t_options		opts;
 	t_ambient_light	ambl;
 	t_camera		cam;
 	t_light			*light;
+	t_light			*light_last;
+	t_arena			light_arena;
+	t_light_tree	light_tree;
 	t_object		*object;
+	t_object		*object_last;
+	t_arena			arena;
+	t_instances		instances;
+	t_anim			anim;
 	t_world			world;
+	t_tex_cache		*textures;
+	int				watch_fd;
 	mlx_t			*ptr;
 	mlx_image_t		*img;
+	t_framebuffer	fb;
+	t_gbuffer		gbuf;
+	bool			relight;
+	t_heatmap		heat;
 	mlx_image_t		*front;
 	mlx_image_t		*bar_bg;
 	mlx_image_t		*bar_fill;
 	mlx_image_t		*bar_text;
 	int				render_mode;
 	t_state			state;
-	int				lines_done;
-	int				total_lines;
+	t_tile			region;
+	int32_t			drag_from[2];
+	bool			dragging;
+	int				next_tile;
+	int				tiles_done;
+	int				total_tiles;
+	unsigned char	*tile_done;
+	t_object		**visible;
+	t_checkpoint	ckpt;
 	pthread_mutex_t	render_mutex;
 	pthread_t		threads[NUM_THREADS];
 	t_render_ctx	thread_ctx[NUM_THREADS];
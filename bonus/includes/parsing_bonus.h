@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 07:16:17 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 11:49:19 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -16,6 +16,11 @@
 # include "types_bonus.h"
 
 typedef struct s_data	t_data;
+typedef struct s_tex_cache	t_tex_cache;
+
+// 64-bit FNV-1a parameters, used to fingerprint scene files
+# define FNV_OFFSET 14695981039346656037ULL
+# define FNV_PRIME 1099511628211ULL
 
 void	errors_map(int code);
 bool	check_extension(char *file);
@@ -32,8 +37,14 @@ void	check_parsed_data(t_data *data);
 void	print_matrix(const char *label, t_matrix m);
 void	debug_world_state(t_world world, t_camera cam);
 bool	parse_material_params(char **fields, int start_idx, t_material *mat, 
-			mlx_t *mlx);
+			t_tex_cache *textures);
 int		count_fields(char **fields);
+bool	parse_options(int argc, char **argv, t_options *opts);
+uint64_t	hash_bytes(uint64_t hash, const void *data, size_t size);
+bool	scene_hash(char *path, uint64_t *hash);
+t_mesh_data	*mesh_load(char *path);
+bool	object_extract(char *line, t_data *data);
+bool	parse_light_range(char *field, float *range);
 
 #endif
 
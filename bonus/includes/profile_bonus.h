@@ -0,0 +1,88 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   profile_bonus.h                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 02:04:46 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 00:19:51 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PROFILE_BONUS_H
+# define PROFILE_BONUS_H
+
+# include <stdint.h>
+# include <stdbool.h>
+
+// Spans kept per thread; a full ring overwrites its oldest spans
+# define PROF_RING_SIZE 16384
+// Trace written at exit (%d is the pid) unless MINIRT_TRACE_FILE is set
+# define PROF_FILE "minirt_trace_%d.json"
+// MINIRT_TRACE_FILE gets the pid too, so forked workers keep their traces
+# define PROF_FILE_ENV "%s.%d"
+
+/*
+** Pipeline spans for `make TRACE=1` (-DMINIRT_TRACE): each thread appends
+** to its own ring, so recording takes no lock, and every ring is dumped as
+** a Chrome / Perfetto JSON trace at exit. Without MINIRT_TRACE the calls
+** below are empty inlines and compile away.
+**
+**     start = prof_now();
+**     ...
+**     prof_span("setup_world", start, -1);
+*/
+typedef struct s_prof_span
+{
+	const char	*name;
+	uint64_t	start;
+	uint64_t	end;
+	int			arg;
+}	t_prof_span;
+
+typedef struct s_prof_ring
+{
+	t_prof_span			spans[PROF_RING_SIZE];
+	uint64_t			count;
+	const char			*thread;
+	int					tid;
+	bool				busy;
+	struct s_prof_ring	*next;
+}	t_prof_ring;
+
+# ifdef MINIRT_TRACE
+
+uint64_t	prof_now(void);
+void		prof_span(const char *name, uint64_t start, int arg);
+void		prof_thread(const char *name);
+void		prof_fork(void);
+void		prof_dump(void);
+t_prof_ring	*prof_rings(void);
+
+# else
+
+static inline uint64_t	prof_now(void)
+{
+	return (0);
+}
+
+static inline void	prof_span(const char *name, uint64_t start, int arg)
+{
+	(void)name;
+	(void)start;
+	(void)arg;
+}
+
+static inline void	prof_thread(const char *name)
+{
+	(void)name;
+}
+
+static inline void	prof_fork(void)
+{
+}
+
+# endif
+
+#endif
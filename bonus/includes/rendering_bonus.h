@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 07:16:17 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 19:52:50 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -18,16 +18,101 @@
 
 typedef struct s_data	t_data;
 
-mlx_image_t	*render(mlx_t *mlx, t_camera cam, t_world world);
+// Side of the square tiles render workers pull from the shared queue
+# define TILE_SIZE 32
+// Pixels a tile's view frustum is widened by on each side before culling
+# define FRUSTUM_MARGIN 1.0
+// Default seconds between checkpoint writes (--checkpoint-every)
+# define CHECKPOINT_INTERVAL 60.0f
+// Leading bytes of a checkpoint file, NUL included
+# define CHECKPOINT_MAGIC "MRTCKPT"
+// Most rays averaged per pixel (--samples)
+# define MAX_SAMPLES 256
+// R2 sequence steps (1/g, 1/g^2 for the plastic number g) for pixel jitter
+# define R2_ALPHA_X 0.7548776662466927
+# define R2_ALPHA_Y 0.5698402909980532
+// inotify event headers read per call by the scene watcher (names included)
+# define WATCH_EVENTS 256
+// Longest image sequence --frames renders
+# define MAX_FRAMES 100000
+// Frame rate --frames samples the animation at unless --fps is given
+# define DEFAULT_FPS 24.0f
+
+/*
+** Same quantisation tuple_to_pixel always did (clamp, scale in double,
+** truncate), minus the double fmin/fmax calls. NaN maps to 0 like fmax.
+*/
+static inline uint8_t	channel_to_byte(float c)
+{
+	if (!(c > 0.0f))
+		return (0);
+	if (c > 1.0f)
+		c = 1.0f;
+	return ((uint8_t)(c * 255.0));
+}
+
 bool		mlx_image_to_ppm(mlx_image_t *img, char *string, \
 			unsigned int range);
 int			convert_color(t_tuple c);
 void		execute_raytracing(void);
 
-void		start_threaded_render(t_data *data);
+bool		start_threaded_render(t_data *data);
 void		stop_threaded_render(t_data *data);
+bool		restart_render(t_data *data);
 void		*render_thread_func(void *arg);
 uint32_t	tuple_to_pixel(t_tuple color);
+t_tuple		trace_pixel(t_world world, t_camera cam, int x, int y, \
+			int samples);
+
+bool		framebuffer_init(t_framebuffer *fb, int width, int height);
+void		framebuffer_free(t_framebuffer *fb);
+void		framebuffer_store(t_framebuffer *fb, int x, int y, t_tuple color);
+void		framebuffer_resolve(t_framebuffer *fb, mlx_image_t *img, \
+			t_tile tile);
+bool		framebuffer_to_pfm(t_framebuffer *fb, char *path);
+bool		framebuffer_to_ppm(t_framebuffer *fb, char *path);
+void		framebuffer_blit(t_framebuffer *fb, t_tile tile, float *rgb);
+t_tile		tile_rect(int index, int tiles_x, int width, int height);
+t_object	**frustum_objects(t_world *world, t_camera cam, t_tile tile);
+bool		gbuffer_prepare(t_gbuffer *gb, t_camera cam);
+void		gbuffer_free(t_gbuffer *gb);
+t_tuple		trace_gbuffer_pixel(t_gbuffer *gb, t_world world, t_camera cam, \
+			int xy[2]);
+t_tuple		relight_pixel(t_gbuffer *gb, t_world world, int x, int y);
+bool		gbuffer_usable(t_data *data);
+bool		reload_scene(t_data *data);
+void		diff_scene(t_data *data, t_data *fresh, t_scene_diff *diff);
+bool		same_material(t_material *a, t_material *b);
+
+bool		watch_start(t_data *data);
+bool		watch_poll(t_data *data);
+void		watch_stop(t_data *data);
+
+bool		heatmap_prepare(t_heatmap *hm, int width, int height);
+void		heatmap_free(t_heatmap *hm);
+double		heat_clock(void);
+void		heatmap_record(t_heatmap *hm, int x, int y, t_ray_stats *stats);
+char		*heat_name(t_heat metric);
+void		heatmap_report(t_heatmap *hm);
+void		heatmap_show(t_heatmap *hm, t_framebuffer *fb, mlx_image_t *img, \
+			t_heat metric);
+bool		heatmap_write(t_heatmap *hm);
+
+bool		job_region(t_job *job, t_tile *region);
+int			region_tile_count(t_tile region);
+t_tile		region_tile(t_tile region, int index);
+t_tile		span_region(int32_t from[2], int32_t to[2], int width, \
+			int height);
+
+bool		checkpoint_key(t_data *data, uint64_t *key);
+bool		checkpoint_write(t_data *data);
+void		checkpoint_load(t_data *data);
+bool		checkpoint_start(t_data *data);
+void		checkpoint_stop(t_data *data);
+
+void		anim_apply(t_data *data, float time);
+void		anim_free(t_anim *anim);
+int			run_frames(t_data *data);
 
 void		draw_progress_bar(t_data *data);
 void		draw_front_page(t_data *data);
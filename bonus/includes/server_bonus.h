@@ -0,0 +1,85 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   server_bonus.h                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 15:36:55 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 15:36:55 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SERVER_BONUS_H
+# define SERVER_BONUS_H
+
+# include <pthread.h>
+# include "types_bonus.h"
+
+typedef struct s_data	t_data;
+
+// Parsed scenes a render server keeps loaded, least recently used dropped
+# define SCENE_CACHE_SIZE 8
+
+typedef struct s_scene_entry
+{
+	char					*path;
+	uint64_t				hash;
+	t_data					*data;
+	t_camera				camera;
+	struct s_scene_entry	*next;
+}	t_scene_entry;
+
+typedef struct s_scene_cache
+{
+	t_scene_entry	*head;
+	int				count;
+}	t_scene_cache;
+
+/*
+** Threads that outlive a single render. A job is a region of a frame; its
+** tiles land in fb (region-sized) and their indices are appended to
+** finished in completion order so the caller can stream them out.
+*/
+typedef struct s_render_pool
+{
+	pthread_t		*threads;
+	int				thread_count;
+	pthread_mutex_t	mutex;
+	pthread_cond_t	work;
+	pthread_cond_t	done;
+	t_world			world;
+	t_camera		cam;
+	t_tile			region;
+	int				samples;
+	t_framebuffer	fb;
+	int				tiles_x;
+	int				total_tiles;
+	int				next_tile;
+	int				running;
+	int				*finished;
+	int				finished_count;
+	bool			quit;
+}	t_render_pool;
+
+typedef struct s_render_stats
+{
+	float	load_ms;
+	float	render_ms;
+	int		cache_hit;
+	int		tiles;
+}	t_render_stats;
+
+t_scene_entry	*scene_cache_get(t_scene_cache *cache, char *path, bool *hit);
+void			scene_cache_free(t_scene_cache *cache);
+
+bool			pool_start(t_render_pool *pool, int thread_count);
+void			pool_stop(t_render_pool *pool);
+bool			pool_submit(t_render_pool *pool, t_data *data, t_tile region);
+int				pool_collect(t_render_pool *pool, int seen);
+void			pool_cancel(t_render_pool *pool);
+
+int				run_server(t_options *opts);
+int				run_client(t_options *opts);
+
+#endif
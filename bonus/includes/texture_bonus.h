@@ -6,13 +6,15 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/26 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2025/12/28 16:01:41 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 22:42:42 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef TEXTURE_BONUS_H
 # define TEXTURE_BONUS_H
 
+# include <sys/types.h>
+# include <time.h>
 # include "types_bonus.h"
 # ifndef MLX42_TYPES_DECL
 #  define MLX42_TYPES_DECL
@@ -21,6 +23,33 @@ typedef struct mlx_image mlx_image_t;
 typedef struct mlx_texture mlx_texture_t;
 # endif
 
+/*
+** Decoded textures shared between parses of the same scene. An entry is
+** one file as it was on disk (path, size, mtime), so an edited PNG is
+** decoded again while unchanged ones are reused; refs counts the
+** materials using it and the last release frees it.
+*/
+typedef struct s_tex_entry
+{
+	char				*path;
+	off_t				size;
+	struct timespec		mtime;
+	mlx_texture_t		*texture;
+	int					refs;
+	struct s_tex_entry	*next;
+}	t_tex_entry;
+
+typedef struct s_tex_cache
+{
+	t_tex_entry	*entries;
+	int			hits;
+	int			loads;
+}	t_tex_cache;
+
+// Texture Cache
+mlx_texture_t	*texture_acquire(t_tex_cache *cache, char *path);
+void		texture_release(t_tex_cache *cache, mlx_texture_t *texture);
+
 // Texture Sampling
 float		sample_bump_map(mlx_texture_t *texture, float u, float v);
 t_tuple		sample_normal_map(mlx_texture_t *texture, float u, float v);
@@ -36,7 +65,8 @@ t_tuple		apply_normal_map(t_material material, t_tuple normal,
 bool		parse_texture_path(char *param_str, char **out_path);
 bool		parse_texture_strength(char *param_str, float *out_strength);
 bool		load_material_textures(t_material *material, char **params, 
-				mlx_t *mlx);
-void		free_material_textures(t_material *material);
+				t_tex_cache *textures);
+void		free_material_textures(t_material *material,
+				t_tex_cache *textures);
 
 #endif
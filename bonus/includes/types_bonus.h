@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 07:16:17 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 23:22:07 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,6 +15,7 @@
 
 # include <stdint.h>
 # include <stdbool.h>
+# include <time.h>
 
 typedef struct s_matrix
 {
@@ -51,7 +52,8 @@ typedef enum e_obj_type
 	OBJ_SPHERE,
 	OBJ_PLANE,
 	OBJ_CYLINDER,
-	OBJ_CONE
+	OBJ_CONE,
+	OBJ_MESH
 }	t_obj_type;
 
 typedef struct s_color
@@ -69,11 +71,29 @@ typedef struct s_tex
 	t_color	**pixels;
 }	t_tex;
 
+/*
+** Points for the batch pattern path, one array per coordinate (SoA) so the
+** kernels vectorise: x, y, z in, the 0/1 colour pick in mask, the colours
+** out in r, g, b. Every array holds count floats.
+*/
+typedef struct s_pattern_run
+{
+	float	*x;
+	float	*y;
+	float	*z;
+	float	*mask;
+	float	*r;
+	float	*g;
+	float	*b;
+	int		count;
+}	t_pattern_run;
+
 typedef struct s_pattern
 {
     t_tuple		a;
     t_tuple		b;
-	t_tuple     (*at)(struct s_pattern pattern, t_tuple point);
+	t_tuple     (*at)(const struct s_pattern *pattern, t_tuple point);
+	void		(*at_batch)(t_pattern_run *run);
 	t_matrix    transform;
 	t_matrix    inv_transform;
 	bool        has_transform;
@@ -99,6 +119,8 @@ typedef struct s_material
 	bool	has_bump_map;
 	bool	has_normal_map;
 	bool	has_color_texture;
+	bool	casts_shadow;
+	bool	receives_shadow;
 }	t_material;
 
 typedef struct s_sphere
@@ -148,33 +170,217 @@ typedef struct s_cone
 	bool		closed;
 }	t_cone;
 
+/*
+** One OBJ face corner per vertex: position, normal and UV indices into the
+** mesh arrays (-1 when the face gives no normal or UV).
+*/
+typedef struct s_mesh_tri
+{
+	int	v[3];
+	int	n[3];
+	int	t[3];
+}	t_mesh_tri;
+
+/*
+** BVH node over mesh triangles, prototype members or instances. A leaf
+** holds count items from start; an inner node has count 0 and its children
+** at start and start + 1.
+*/
+typedef struct s_bvh_node
+{
+	float	min[3];
+	float	max[3];
+	int		start;
+	int		count;
+}	t_bvh_node;
+
+/*
+** Geometry of one .obj file in object space, triangles stored in BVH leaf
+** order. path and mtime tell a reparse whether the file changed.
+*/
+typedef struct s_mesh_data
+{
+	char			*path;
+	struct timespec	mtime;
+	float			*pos;
+	float			*nrm;
+	float			*uv;
+	int				pos_count;
+	int				nrm_count;
+	int				uv_count;
+	t_mesh_tri		*tris;
+	int				tri_count;
+	t_bvh_node		*nodes;
+	int				node_count;
+}	t_mesh_data;
+
+typedef struct s_mesh
+{
+	t_mesh_data	*geo;
+	t_matrix	trans;
+	t_matrix	trans_inv;
+	t_material	material;
+}	t_mesh;
+
+/*
+** One item as the BVH builder sees it: its box (min xyz, max xyz), its
+** centroid and its index. Building leaves the refs in leaf order.
+*/
+typedef struct s_bvh_ref
+{
+	float	box[6];
+	float	cen[3];
+	int		index;
+}	t_bvh_ref;
+
+/*
+** A ray set up for BVH traversal: inv holds the slab test reciprocals; k
+** is the axis permutation that makes dir[k[2]] the dominant component and
+** shear the matching constants of the watertight triangle test.
+*/
+typedef struct s_bvh_ray
+{
+	float	org[3];
+	float	dir[3];
+	float	inv[3];
+	float	shear[3];
+	int		k[3];
+	float	t_min;
+	float	t_max;
+}	t_bvh_ray;
+
+typedef struct s_mesh_hit
+{
+	float	t;
+	int		prim;
+	float	u;
+	float	v;
+}	t_mesh_hit;
+
 typedef union u_shape
 {
 	t_sphere	sp;
 	t_plane		pl;
 	t_cylinder	cy;
 	t_cone		co;
+	t_mesh		me;
 }	t_shapes;
 
+typedef struct s_bounds
+{
+	t_tuple	min;
+	t_tuple	max;
+	bool	finite;
+}	t_bounds;
+
 typedef struct s_object
 {
 	t_obj_type		type;
 	t_shapes		shape;
+	t_bounds		bounds;
 	struct s_object	*next;
 }	t_object;
 
+/*
+** Shapes declared with def, in their own space; members_last is the tail
+** new members are appended after. order lists the members in BVH leaf
+** order; the BVH is built when the prototype is first instanced, after
+** which it takes no more members.
+*/
+typedef struct s_proto
+{
+	char			*name;
+	t_object		*members;
+	t_object		*members_last;
+	t_object		**order;
+	t_bvh_node		*nodes;
+	int				count;
+	int				node_count;
+	struct s_proto	*next;
+}	t_proto;
+
+/*
+** One inst line: the shared prototype and the world-to-prototype matrix.
+*/
+typedef struct s_instance
+{
+	t_proto		*proto;
+	t_matrix	trans_inv;
+}	t_instance;
+
+/*
+** Every instance of the scene, in top-level BVH leaf order once built.
+** refs holds their world boxes while the file is parsed. transparent is
+** set when any instanced member lets light through.
+*/
+typedef struct s_instances
+{
+	t_proto		*protos;
+	t_instance	*items;
+	t_bvh_ref	*refs;
+	int			count;
+	int			capacity;
+	t_bvh_node	*nodes;
+	int			node_count;
+	bool		transparent;
+}	t_instances;
+
+typedef enum e_light_kind
+{
+	LIGHT_POINT,
+	LIGHT_RECT,
+	LIGHT_SPHERE
+}	t_light_kind;
+
+/*
+** range is where the light has faded out completely; 0 means it never
+** fades, as the mandatory lights do. Area lights are shaded from origin,
+** their centre, and only their shadows use the shape: a rectangle with
+** edges u and v, or a sphere of the given radius.
+*/
 typedef struct s_light
 {
 	t_tuple			origin;
 	t_tuple			color;
 	float			brightness;
+	float			range;
+	t_light_kind	kind;
+	t_tuple			u;
+	t_tuple			v;
+	float			radius;
+	t_object		**occluders;
 	struct s_light	*next;
 }	t_light;
 
+/*
+** Lights grouped for shading. Lights that never fade are tested at every
+** hit (all); ranged ones sit in a BVH over their spheres of influence, in
+** leaf order, so a hit only looks at those that reach it. Lights whose
+** brightest contribution is under the cutoff are in neither.
+*/
+typedef struct s_light_tree
+{
+	t_light		**all;
+	int			all_count;
+	t_light		**ranged;
+	int			ranged_count;
+	t_bvh_node	*nodes;
+	int			node_count;
+}	t_light_tree;
+
+/*
+** prim, u and v locate a mesh hit (triangle and barycentrics of its second
+** and third vertex); other shapes leave prim at -1. inst is the instance a
+** prototype member was hit through, NULL for scene objects.
+*/
 typedef struct s_inters
 {
 	float				t;
 	t_object			*object;
+	int					prim;
+	float				u;
+	float				v;
+	t_instance			*inst;
 	struct s_inters		*next;
 }	t_inters;
 
@@ -198,28 +404,336 @@ typedef struct s_camera
 	t_tuple		up;
 }	t_camera;
 
+/*
+** obj_point is point in the space obj's own transform starts from: the
+** world for scene objects, the prototype's space for instanced members.
+** local_point (in obj's own space) and color (what the lights see: the
+** pattern, the material colour, or white under a texture) are filled once
+** per hit by shade_surface and read by every light after it.
+*/
 typedef struct s_computations
 {
 	float		t;
 	t_object	*obj;
+	t_instance	*inst;
 	t_tuple		point;
+	t_tuple		obj_point;
+	t_tuple		local_point;
+	t_tuple		color;
 	t_tuple		eyev;
 	t_tuple		normalv;
 	t_tuple		reflectv;
 	t_tuple		over_point;
 	t_tuple		under_point;
+	t_tuple		uv;
 	bool		inside;
 	float		n1;
 	float		n2;
 }	t_comps;
 
+typedef struct s_bounce
+{
+	t_ray	ray;
+	float	weight;
+	float	scale;
+}	t_bounce;
+
+typedef enum e_trace_stage
+{
+	TRACE_REFRACT,
+	TRACE_REFLECT,
+	TRACE_BLEND
+}	t_trace_stage;
+
+typedef struct s_trace_frame
+{
+	t_comps			comps;
+	t_tuple			surface;
+	t_tuple			refracted;
+	t_tuple			reflected;
+	float			weight;
+	float			scale;
+	float			reflectance;
+	int				depth;
+	t_trace_stage	stage;
+	bool			traced_refract;
+	bool			traced_reflect;
+}	t_trace_frame;
+
+/*
+** light_cutoff drops a light wherever its contribution is below it;
+** light_samples > 0 shades that many lights per hit, picked at random in
+** proportion to their contribution, instead of all of them.
+*/
+typedef struct s_trace_opts
+{
+	float	min_weight;
+	bool	russian_roulette;
+	float	light_cutoff;
+	int		light_samples;
+}	t_trace_opts;
+
+/*
+** Cost of one pixel for --heatmap: CPU seconds, shape intersection tests
+** (primary, secondary and shadow rays), shadow rays cast, and the deepest
+** bounce level color_at reached (1 for a hit with no secondary ray).
+*/
+typedef struct s_ray_stats
+{
+	float		seconds;
+	uint32_t	tests;
+	uint32_t	shadow_rays;
+	uint32_t	depth;
+}	t_ray_stats;
+
+/*
+** primary, when set, is the NULL-terminated list of objects the first ray
+** of color_at tests instead of the whole list: the visible set of the tile
+** being traced. Secondary rays always see every object.
+*/
 typedef struct s_world
 {
-	t_object	*objects;
-	t_light		*lights;
-	t_tuple		ambient_color;
+	t_object		*objects;
+	t_object		**primary;
+	t_instances		*instances;
+	t_light			*lights;
+	t_light_tree	*light_tree;
+	t_tuple			ambient_color;
+	t_trace_opts	trace;
+	t_ray_stats		*stats;
 }	t_world;
 
+/*
+** Scene-lifetime bump allocator (arena_bonus.c). Chunks are chained newest
+** first; only the newest one is ever allocated from.
+*/
+typedef struct s_arena_chunk
+{
+	struct s_arena_chunk	*next;
+	size_t					used;
+	size_t					size;
+}	t_arena_chunk;
+
+typedef struct s_arena
+{
+	t_arena_chunk	*chunks;
+}	t_arena;
+
+typedef struct s_framebuffer
+{
+	int		width;
+	int		height;
+	float	*rgb;
+}	t_framebuffer;
+
+/*
+** First hit of one pixel's primary ray, enough to rebuild its t_comps
+** without tracing it again. A NULL obj is a miss. The ray origin is the
+** camera's and lives in the buffer; the normal is the final one (after
+** bump and normal maps, flipped when inside).
+*/
+typedef struct s_gsample
+{
+	t_object	*obj;
+	t_instance	*inst;
+	t_tuple		direction;
+	t_tuple		normalv;
+	float		t;
+	float		n1;
+	float		n2;
+	float		u;
+	float		v;
+	bool		inside;
+}	t_gsample;
+
+typedef struct s_gbuffer
+{
+	int			width;
+	int			height;
+	t_tuple		origin;
+	t_gsample	*px;
+	bool		valid;
+	bool		filling;
+}	t_gbuffer;
+
+/*
+** What reparsing the scene file changed. view, geometry and surfaces
+** invalidate G-buffer records; the rest only changes shading.
+*/
+typedef struct s_scene_diff
+{
+	bool	view;
+	bool	geometry;
+	bool	surfaces;
+	bool	lights;
+	bool	ambient;
+	bool	shadows;
+	int		materials;
+}	t_scene_diff;
+
+typedef enum e_anim_kind
+{
+	ANIM_NONE,
+	ANIM_CAMERA,
+	ANIM_LIGHT,
+	ANIM_OBJECT
+}	t_anim_kind;
+
+/*
+** Animated properties: pos is the camera's or light's position, or the
+** point an object is rotated about; look is where the camera aims; rot is
+** an object's rotation in degrees about x, y and z.
+*/
+typedef enum e_anim_prop
+{
+	PROP_POS,
+	PROP_LOOK,
+	PROP_ROT,
+	ANIM_PROPS
+}	t_anim_prop;
+
+typedef struct s_anim_key
+{
+	float	time;
+	t_tuple	value;
+}	t_anim_key;
+
+/*
+** Keyframes of one camera, light or object, in time order for each
+** property. An object also keeps the pose it was parsed with (rest), and
+** a cone keeps its centre and axis, so every frame starts again from it.
+*/
+typedef struct s_track
+{
+	t_anim_kind		kind;
+	void			*target;
+	t_anim_key		*keys[ANIM_PROPS];
+	int				count[ANIM_PROPS];
+	t_matrix		rest;
+	t_tuple			rest_center;
+	t_tuple			rest_axis;
+	struct s_track	*next;
+}	t_track;
+
+/*
+** All tracks of the scene. last is what the previous scene line defined,
+** which an anim line attaches to; end is the time of the last key.
+*/
+typedef struct s_anim
+{
+	t_track		*tracks;
+	t_anim_kind	last;
+	float		end;
+}	t_anim;
+
+/*
+** What the window shows: the render itself or one per-pixel cost map.
+*/
+typedef enum e_heat
+{
+	HEAT_COLOR,
+	HEAT_TIME,
+	HEAT_TESTS,
+	HEAT_SHADOWS,
+	HEAT_DEPTH,
+	HEAT_VIEWS
+}	t_heat;
+
+typedef struct s_heatmap
+{
+	int				width;
+	int				height;
+	float			*plane[HEAT_VIEWS];
+	t_framebuffer	view;
+	t_heat			shown;
+}	t_heatmap;
+
+typedef struct s_tile
+{
+	int	x;
+	int	y;
+	int	w;
+	int	h;
+}	t_tile;
+
+/*
+** Everything that describes one render of a parsed scene. A zero-sized
+** region means the whole frame; the camera override, when set, replaces
+** the scene's C line (position, direction, fov in degrees).
+*/
+typedef struct s_job
+{
+	int				width;
+	int				height;
+	int				samples;
+	t_tile			region;
+	bool			has_camera;
+	t_tuple			eye;
+	t_tuple			dir;
+	float			fov;
+	t_trace_opts	trace;
+}	t_job;
+
+typedef struct s_options
+{
+	char			*scene;
+	t_job			job;
+	char			*output;
+	char			*listen;
+	char			*worker;
+	char			*serve;
+	char			*connect;
+	int				workers;
+	float			tile_timeout;
+	char			*checkpoint;
+	float			checkpoint_every;
+	bool			resume;
+	bool			gbuffer;
+	t_heat			heatmap;
+	int				frames;
+	float			fps;
+}	t_options;
+
+/*
+** Checkpoint file: this header, one done byte per tile, then the float RGB
+** of every done tile in index order (tile.w * tile.h * 3 floats each).
+*/
+typedef struct s_ckpt_header
+{
+	char		magic[8];
+	uint64_t	key;
+	int32_t		width;
+	int32_t		height;
+	int32_t		tile_size;
+	int32_t		total_tiles;
+}	t_ckpt_header;
+
+typedef enum e_msg_type
+{
+	MSG_SCENE,
+	MSG_READY,
+	MSG_FAIL,
+	MSG_TILE,
+	MSG_RESULT,
+	MSG_DONE,
+	MSG_RENDER
+}	t_msg_type;
+
+typedef struct s_msg_header
+{
+	uint32_t	type;
+	uint32_t	size;
+}	t_msg_header;
+
+typedef struct s_peer
+{
+	int		fd;
+	int		pid;
+	int		tile;
+	double	deadline;
+	bool	ready;
+}	t_peer;
+
 // typedef struct s_screen
 // {
 // 	double	x;
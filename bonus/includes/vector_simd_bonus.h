@@ -0,0 +1,256 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   vector_simd_bonus.h                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 15:47:28 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 15:47:28 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef VECTOR_SIMD_BONUS_H
+# define VECTOR_SIMD_BONUS_H
+
+/*
+** Header-only tuple math. Every operation is static inline so the hot
+** paths in geometry, lighting and shading compile to a handful of
+** instructions instead of a call per add. On x86 each t_tuple is moved
+** into one __m128; elsewhere (or with make NO_SIMD=1) the plain scalar
+** bodies are used. Both paths round exactly like the former out-of-line
+** functions: lane-wise ops are IEEE identical and the dot product keeps
+** the ((x + y) + z) + w summation order, so renders do not change.
+*/
+
+# include <math.h>
+# include "types_bonus.h"
+
+# if defined(__SSE2__) && !defined(MINIRT_NO_SIMD)
+#  define VEC_SIMD 1 // __m128 backed
+#  include <emmintrin.h>
+# else
+#  define VEC_SIMD 0 // scalar fallback
+# endif
+
+# if VEC_SIMD
+
+static inline __m128	vec_load(t_tuple a)
+{
+	return (_mm_setr_ps(a.x, a.y, a.z, a.w));
+}
+
+static inline t_tuple	vec_store(__m128 v)
+{
+	t_tuple	r;
+
+	_mm_storeu_ps(&r.x, v);
+	return (r);
+}
+
+/*
+** Horizontal sum in the scalar order ((x + y) + z) + w, one lane at a
+** time, so the rounding matches the former function bit for bit.
+*/
+static inline float	vec_hsum(__m128 m)
+{
+	__m128	s;
+
+	s = _mm_add_ss(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 1, 1, 1)));
+	s = _mm_add_ss(s, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 2, 2, 2)));
+	s = _mm_add_ss(s, _mm_shuffle_ps(m, m, _MM_SHUFFLE(3, 3, 3, 3)));
+	return (_mm_cvtss_f32(s));
+}
+
+static inline __m128	vec_mask_w(__m128 v)
+{
+	return (_mm_and_ps(v, _mm_castsi128_ps(
+				_mm_setr_epi32(-1, -1, -1, 0))));
+}
+
+static inline t_tuple	add_tuple(t_tuple a, t_tuple b)
+{
+	return (vec_store(_mm_add_ps(vec_load(a), vec_load(b))));
+}
+
+static inline t_tuple	substract_tuple(t_tuple a, t_tuple b)
+{
+	return (vec_store(_mm_sub_ps(vec_load(a), vec_load(b))));
+}
+
+static inline t_tuple	negate_tuple(t_tuple a)
+{
+	return (vec_store(_mm_xor_ps(vec_load(a), _mm_set1_ps(-0.0f))));
+}
+
+static inline t_tuple	tuple_scalar_mult(t_tuple a, float scalar)
+{
+	return (vec_store(_mm_mul_ps(vec_load(a), _mm_set1_ps(scalar))));
+}
+
+static inline t_tuple	tuple_scalar_divide(t_tuple a, float scalar)
+{
+	return (vec_store(_mm_div_ps(vec_load(a), _mm_set1_ps(scalar))));
+}
+
+static inline t_tuple	mult_tuple(t_tuple a, t_tuple b)
+{
+	return (vec_store(_mm_mul_ps(vec_load(a), vec_load(b))));
+}
+
+static inline t_tuple	hadamard_product(t_tuple a, t_tuple b)
+{
+	return (vec_store(vec_mask_w(_mm_mul_ps(vec_load(a), vec_load(b)))));
+}
+
+static inline float	vecs_dot_product(t_tuple va, t_tuple vb)
+{
+	return (vec_hsum(_mm_mul_ps(vec_load(va), vec_load(vb))));
+}
+
+static inline t_tuple	vecs_cross_product(t_tuple va, t_tuple vb)
+{
+	__m128	a;
+	__m128	b;
+	__m128	c;
+
+	a = vec_load(va);
+	b = vec_load(vb);
+	c = _mm_sub_ps(
+			_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)),
+				_mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2))),
+			_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2)),
+				_mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1))));
+	return (vec_store(vec_mask_w(c)));
+}
+
+static inline float	vector_magnitude(t_tuple v)
+{
+	__m128	a;
+
+	a = vec_load(v);
+	return (_mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(
+					vec_hsum(_mm_mul_ps(a, a))))));
+}
+
+static inline t_tuple	normalizing_vector(t_tuple v)
+{
+	float	mag;
+
+	mag = vector_magnitude(v);
+	if (mag == 0)
+		return (v);
+	return (vec_store(vec_mask_w(_mm_div_ps(vec_load(v),
+					_mm_set1_ps(mag)))));
+}
+
+/*
+** rsqrtss estimate (12 bits) refined by one Newton-Raphson step to ~22
+** bits: y' = y * (1.5 - 0.5 * x * y * y). The squared length is summed
+** as a tree, not in scalar order, so results may differ in the last ulp.
+** On cores with a fast divider it is no quicker than normalizing_vector
+** (make bench_vectors), so the renderer keeps the exact version.
+*/
+static inline t_tuple	normalizing_vector_fast(t_tuple v)
+{
+	__m128	a;
+	__m128	x;
+	__m128	y;
+
+	a = vec_load(v);
+	x = _mm_mul_ps(a, a);
+	x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+	x = _mm_add_ss(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1)));
+	if (_mm_cvtss_f32(x) == 0)
+		return (v);
+	y = _mm_rsqrt_ss(x);
+	y = _mm_mul_ss(y, _mm_sub_ss(_mm_set_ss(1.5f), _mm_mul_ss(
+					_mm_mul_ss(_mm_set_ss(0.5f), x), _mm_mul_ss(y, y))));
+	y = _mm_shuffle_ps(y, y, _MM_SHUFFLE(0, 0, 0, 0));
+	return (vec_store(vec_mask_w(_mm_mul_ps(a, y))));
+}
+
+# else
+
+static inline t_tuple	add_tuple(t_tuple a, t_tuple b)
+{
+	return ((t_tuple){a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w});
+}
+
+static inline t_tuple	substract_tuple(t_tuple a, t_tuple b)
+{
+	return ((t_tuple){a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w});
+}
+
+static inline t_tuple	negate_tuple(t_tuple a)
+{
+	return ((t_tuple){-a.x, -a.y, -a.z, -a.w});
+}
+
+static inline t_tuple	tuple_scalar_mult(t_tuple a, float scalar)
+{
+	return ((t_tuple){a.x * scalar, a.y * scalar, a.z * scalar, a.w * scalar});
+}
+
+static inline t_tuple	tuple_scalar_divide(t_tuple a, float scalar)
+{
+	return ((t_tuple){a.x / scalar, a.y / scalar, a.z / scalar, a.w / scalar});
+}
+
+static inline t_tuple	mult_tuple(t_tuple a, t_tuple b)
+{
+	return ((t_tuple){a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w});
+}
+
+static inline t_tuple	hadamard_product(t_tuple a, t_tuple b)
+{
+	return ((t_tuple){a.x * b.x, a.y * b.y, a.z * b.z, 0});
+}
+
+static inline float	vecs_dot_product(t_tuple va, t_tuple vb)
+{
+	return (va.x * vb.x + va.y * vb.y + va.z * vb.z + va.w * vb.w);
+}
+
+static inline t_tuple	vecs_cross_product(t_tuple va, t_tuple vb)
+{
+	return ((t_tuple){va.y * vb.z - va.z * vb.y, va.z * vb.x - va.x * vb.z, \
+		va.x * vb.y - va.y * vb.x, 0});
+}
+
+static inline float	vector_magnitude(t_tuple v)
+{
+	return (sqrtf(v.x * v.x + v.y * v.y + v.z * v.z + v.w * v.w));
+}
+
+static inline t_tuple	normalizing_vector(t_tuple v)
+{
+	float	mag;
+
+	mag = vector_magnitude(v);
+	if (mag == 0)
+		return (v);
+	return ((t_tuple){v.x / mag, v.y / mag, v.z / mag, 0});
+}
+
+static inline t_tuple	normalizing_vector_fast(t_tuple v)
+{
+	float	len2;
+	float	inv;
+
+	len2 = vecs_dot_product(v, v);
+	if (len2 == 0)
+		return (v);
+	inv = 1.0f / sqrtf(len2);
+	return ((t_tuple){v.x * inv, v.y * inv, v.z * inv, 0});
+}
+
+# endif
+
+static inline t_tuple	reflect(t_tuple in, t_tuple normal)
+{
+	return (substract_tuple(in, tuple_scalar_mult(normal, \
+		2 * vecs_dot_product(in, normal))));
+}
+
+#endif
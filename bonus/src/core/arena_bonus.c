@@ -0,0 +1,74 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   arena_bonus.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 17:21:17 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 19:23:58 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+/*
+** Bump allocator for everything that lives exactly as long as a scene.
+** Memory comes in ARENA_CHUNK blocks (or one block of its own for a
+** larger request); each allocation just moves the fill mark of the newest
+** block, and arena_free hands all blocks back at once.
+*/
+
+static size_t	arena_align(size_t size)
+{
+	return ((size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1));
+}
+
+static t_arena_chunk	*arena_grow(t_arena *arena, size_t size)
+{
+	t_arena_chunk	*chunk;
+	size_t			capacity;
+
+	capacity = ARENA_CHUNK;
+	if (size > capacity)
+		capacity = size;
+	chunk = malloc(arena_align(sizeof(t_arena_chunk)) + capacity);
+	if (!chunk)
+		return (NULL);
+	chunk->used = 0;
+	chunk->size = capacity;
+	chunk->next = arena->chunks;
+	arena->chunks = chunk;
+	return (chunk);
+}
+
+void	*arena_alloc(t_arena *arena, size_t size)
+{
+	t_arena_chunk	*chunk;
+	void			*mem;
+
+	size = arena_align(size);
+	chunk = arena->chunks;
+	if (!chunk || chunk->size - chunk->used < size)
+		chunk = arena_grow(arena, size);
+	if (!chunk)
+		return (NULL);
+	mem = (char *)chunk + arena_align(sizeof(t_arena_chunk)) + chunk->used;
+	chunk->used += size;
+	return (mem);
+}
+
+void	arena_free(t_arena *arena)
+{
+	t_arena_chunk	*chunk;
+	t_arena_chunk	*next;
+
+	chunk = arena->chunks;
+	while (chunk)
+	{
+		next = chunk->next;
+		free(chunk);
+		chunk = next;
+	}
+	arena->chunks = NULL;
+}
@@ -6,106 +6,121 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 07:26:50 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 16:45:12 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "../../includes/miniRT_bonus.h"
 #include "../../includes/texture_bonus.h"
 
-static t_comps	*new_comps(void)
+static void	init_comps(t_comps *comp)
 {
-	t_comps	*comp;
-
-	comp = malloc(sizeof(t_comps));
-	if (!comp)
-		return (NULL);
 	comp->eyev = (t_tuple){0, 0, 0, 0};
 	comp->normalv = (t_tuple){0, 0, 0, 0};
 	comp->point = (t_tuple){0, 0, 0, 1};
+	comp->obj_point = (t_tuple){0, 0, 0, 1};
+	comp->local_point = (t_tuple){0, 0, 0, 1};
+	comp->color = (t_tuple){0, 0, 0, 0};
+	comp->inst = NULL;
 	comp->over_point = (t_tuple){0, 0, 0, 1};
 	comp->under_point = (t_tuple){0, 0, 0, 1};
 	comp->t = 0.0;
 	comp->obj = NULL;
 	comp->inside = false;
+	comp->uv = (t_tuple){0, 0, 0, 0};
 	comp->n1 = 1.0;
 	comp->n2 = 1.0;
-	return (comp);
 }
 
-static void	get_normal_vector(t_comps *new)
+static void	get_normal_vector(t_comps *new, t_inters *hit)
 {
 	if (new->obj->type == OBJ_SPHERE)
-		new->normalv = sphere_normal_at(new->obj->shape.sp, new->point);
+		new->normalv = sphere_normal_at(new->obj->shape.sp, new->obj_point);
 	else if (new->obj->type == OBJ_PLANE)
 		new->normalv = plane_normal_at(new->obj->shape.pl);
 	else if (new->obj->type == OBJ_CYLINDER)
-		new->normalv = cylinder_normal_at(new->obj->shape.cy, new->point);
+		new->normalv = cylinder_normal_at(new->obj->shape.cy, new->obj_point);
 	else if (new->obj->type == OBJ_CONE)
-		new->normalv = cone_normal_at(new->obj->shape.co, new->point);
+		new->normalv = cone_normal_at(new->obj->shape.co, new->obj_point);
+	else if (new->obj->type == OBJ_MESH)
+		new->normalv = mesh_normal_at(&new->obj->shape.me, hit);
 }
 
-static t_tuple	get_local_point(t_comps *comp)
+/*
+** The hit in the object's own space, where its UVs, bump maps and
+** patterns are defined.
+*/
+t_tuple	comps_local_point(t_comps *comp)
 {
-	if (comp->obj->type == OBJ_SPHERE)
-		return (multiply_matrix_by_tuple(
-			comp->obj->shape.sp.trans_inv, comp->point));
-	else if (comp->obj->type == OBJ_PLANE)
-		return (multiply_matrix_by_tuple(
-			comp->obj->shape.pl.trans_inv, comp->point));
-	else if (comp->obj->type == OBJ_CYLINDER)
-		return (multiply_matrix_by_tuple(
-			comp->obj->shape.cy.trans_inv, comp->point));
-	else if (comp->obj->type == OBJ_CONE)
-		return (multiply_matrix_by_tuple(
-			comp->obj->shape.co.trans_inv, comp->point));
-	return (comp->point);
+	t_matrix	*trans;
+	t_matrix	*inv;
+
+	object_transforms(comp->obj, &trans, &inv);
+	return (multiply_matrix_by_tuple(*inv, comp->obj_point));
 }
 
-static t_material	get_material(t_comps *comp)
+static t_tuple	surface_uv(t_obj_type type, t_tuple local_point)
 {
-	if (comp->obj->type == OBJ_SPHERE)
-		return (comp->obj->shape.sp.material);
-	else if (comp->obj->type == OBJ_PLANE)
-		return (comp->obj->shape.pl.material);
-	else if (comp->obj->type == OBJ_CYLINDER)
-		return (comp->obj->shape.cy.material);
-	else if (comp->obj->type == OBJ_CONE)
-		return (comp->obj->shape.co.material);
-	return (material());
+	if (type == OBJ_SPHERE)
+		return (sphere_uv_mapping(local_point));
+	else if (type == OBJ_PLANE)
+		return (plane_uv_mapping(local_point));
+	else if (type == OBJ_CYLINDER)
+		return (cylinder_uv_mapping(local_point));
+	return (cone_uv_mapping(local_point));
 }
 
-static void	apply_texture_mapping(t_comps *comp)
+/*
+** Perturbs the normal by the bump and normal maps and, for a colour
+** texture, keeps the UV it is sampled at (shade_surface reads it, and the
+** G-buffer stores it). Meshes take their UV from the hit triangle and are
+** never bump or normal mapped (the parser refuses it).
+*/
+static void	apply_texture_mapping(t_comps *comp, t_inters *hit)
 {
-	t_material	mat;
+	t_material	*mat;
 	t_tuple		local_point;
 
-	mat = get_material(comp);
-	if (!mat.has_bump_map && !mat.has_normal_map)
+	mat = object_material(comp->obj);
+	if (!mat || (!mat->has_bump_map && !mat->has_normal_map
+			&& !mat->has_color_texture))
 		return ;
-	local_point = get_local_point(comp);
-	if (mat.has_bump_map && mat.bump_map != NULL)
-		comp->normalv = perturb_normal_with_bump(mat, comp->normalv,
+	if (comp->obj->type == OBJ_MESH)
+	{
+		if (mat->has_color_texture && mat->color_texture != NULL)
+			comp->uv = mesh_uv_at(&comp->obj->shape.me, hit);
+		return ;
+	}
+	local_point = comps_local_point(comp);
+	if (mat->has_color_texture && mat->color_texture != NULL)
+		comp->uv = surface_uv(comp->obj->type, local_point);
+	if (mat->has_bump_map && mat->bump_map != NULL)
+		comp->normalv = perturb_normal_with_bump(*mat, comp->normalv,
 				local_point, comp->obj->type);
-	if (mat.has_normal_map && mat.normal_map != NULL)
-		comp->normalv = apply_normal_map(mat, comp->normalv,
+	if (mat->has_normal_map && mat->normal_map != NULL)
+		comp->normalv = apply_normal_map(*mat, comp->normalv,
 				local_point, comp->obj->type);
 }
 
-t_comps	*prepare_computations(t_inters *intersection, t_ray ray, t_inters *intersections)
+void	prepare_computations(t_inters *intersection, t_ray ray, \
+	t_inters *intersections, t_comps *new)
 {
-	t_comps	*new;
 	t_tuple	original_normal;
 
-	new = new_comps();
-	if (!new)
-		return (NULL);
+	init_comps(new);
 	new->t = intersection->t;
 	new->obj = intersection->object;
+	new->inst = intersection->inst;
 	new->point = position(ray, new->t);
+	new->obj_point = new->point;
+	if (new->inst)
+		new->obj_point = multiply_matrix_by_tuple(new->inst->trans_inv,
+				new->point);
 	new->eyev = negate_tuple(ray.direction);
-	get_normal_vector(new);
-	apply_texture_mapping(new);
+	get_normal_vector(new, intersection);
+	apply_texture_mapping(new, intersection);
+	if (new->inst)
+		new->normalv = instance_normal(new->inst, new->normalv);
 	original_normal = new->normalv;
 	if (vecs_dot_product(new->normalv, new->eyev) < 0)
 	{
@@ -126,5 +141,4 @@ t_comps	*prepare_computations(t_inters *intersection, t_ray ray, t_inters *inter
 	}
 	new->reflectv = reflect(ray.direction, new->normalv);
 	compute_n1_n2(intersection, intersections, new);
-	return (new);
 }
@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 07:26:50 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 20:07:16 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,102 +14,131 @@
 
 // No cone-specific shadow fast path; use the same flow as other shapes
 
+void	intersect_object(t_object *obj, t_ray ray, t_inters **xs)
+{
+	if (obj->type == OBJ_SPHERE)
+		intersect_sphere(&obj->shape.sp,
+			transform_ray(ray, obj->shape.sp.trans_inv), xs, obj);
+	else if (obj->type == OBJ_PLANE)
+		intersect_plane(&obj->shape.pl,
+			transform_ray(ray, obj->shape.pl.trans_inv), xs, obj);
+	else if (obj->type == OBJ_CYLINDER)
+		intersect_cylinder(&obj->shape.cy,
+			transform_ray(ray, obj->shape.cy.trans_inv), xs, obj);
+	else if (obj->type == OBJ_CONE)
+		intersect_cone(&obj->shape.co, ray, xs, obj);
+	else if (obj->type == OBJ_MESH)
+		intersect_mesh(&obj->shape.me,
+			transform_ray(ray, obj->shape.me.trans_inv), xs, obj);
+}
+
+/*
+** Objects whose bounds the ray misses are skipped before any transform or
+** quadratic solve. Only hits at t >= 0 are culled this way: the sphere test
+** also reports hits behind the origin, but those come in pairs that cancel
+** out in compute_n1_n2, so the result is unchanged.
+*/
+static void	intersect_candidate(t_world *world, t_object *obj, t_ray ray,
+		t_inters **xs)
+{
+	if (!ray_hits_bounds(&obj->bounds, ray, INFINITY))
+		return ;
+	if (world->stats)
+		world->stats->tests++;
+	intersect_object(obj, ray, xs);
+}
+
+/*
+** A primary ray only tests its tile's visible set when there is one.
+** Instances are found through their own two-level BVH.
+*/
 t_inters	*intersect_world(t_world world, t_ray ray)
 {
 	t_object	*obj;
+	t_object	**set;
 	t_inters	*all_intersections;
-	t_ray		transformed_ray;
 
-	obj = world.objects;
 	all_intersections = NULL;
-	while (obj)
+	set = world.primary;
+	while (set && *set)
+		intersect_candidate(&world, *set++, ray, &all_intersections);
+	obj = world.objects;
+	while (!set && obj)
 	{
-		if (obj->type == OBJ_SPHERE)
-		{
-			transformed_ray = transform_ray(ray, obj->shape.sp.trans_inv);
-			intersect_sphere(&obj->shape.sp, transformed_ray, \
-				&all_intersections, obj);
-		}
-		else if (obj->type == OBJ_PLANE)
-		{
-			transformed_ray = transform_ray(ray, obj->shape.pl.trans_inv);
-			intersect_plane(&obj->shape.pl, transformed_ray, \
-				&all_intersections, obj);
-		}
-		else if (obj->type == OBJ_CYLINDER)
-		{
-			transformed_ray = transform_ray(ray, obj->shape.cy.trans_inv);
-			intersect_cylinder(&obj->shape.cy, transformed_ray, \
-				&all_intersections, obj);
-		}
-		else if (obj->type == OBJ_CONE)
-		{
-			intersect_cone(&obj->shape.co, ray, &all_intersections, obj);
-		}
+		intersect_candidate(&world, obj, ray, &all_intersections);
 		obj = obj->next;
 	}
+	intersect_instances(world.instances, ray, &all_intersections,
+		world.stats);
 	sort_intersections(&all_intersections);
 	return (all_intersections);
 }
 
+static void	free_intersections(t_inters *intersections)
+{
+	t_inters	*temp;
 
-bool	intersect_world_shadow(t_world world, t_ray ray, float max_distance)
+	while (intersections)
+	{
+		temp = intersections->next;
+		free(intersections);
+		intersections = temp;
+	}
+}
+
+bool	blocks_shadow_ray(t_object *obj, t_ray ray, float max_distance,
+		t_ray_stats *stats)
 {
-	t_object	*obj;
 	t_inters	*intersections;
 	t_inters	*current;
-	t_inters	*temp;
-	t_ray		transformed_ray;
 
-	obj = world.objects;
+	if (!ray_hits_bounds(&obj->bounds, ray, max_distance))
+		return (false);
+	if (stats)
+		stats->tests++;
+	if (obj->type == OBJ_MESH)
+		return (mesh_occludes(&obj->shape.me,
+				transform_ray(ray, obj->shape.me.trans_inv), max_distance));
 	intersections = NULL;
-	while (obj)
+	intersect_object(obj, ray, &intersections);
+	current = intersections;
+	while (current)
 	{
-		if (obj->type == OBJ_SPHERE)
-		{
-			transformed_ray = transform_ray(ray, obj->shape.sp.trans_inv);
-			intersect_sphere(&obj->shape.sp, transformed_ray, \
-				&intersections, obj);
-		}
-		else if (obj->type == OBJ_PLANE)
-		{
-			transformed_ray = transform_ray(ray, obj->shape.pl.trans_inv);
-			intersect_plane(&obj->shape.pl, transformed_ray, \
-				&intersections, obj);
-		}
-		else if (obj->type == OBJ_CYLINDER)
-		{
-			transformed_ray = transform_ray(ray, obj->shape.cy.trans_inv);
-			intersect_cylinder(&obj->shape.cy, transformed_ray, \
-				&intersections, obj);
-		}
-		else if (obj->type == OBJ_CONE)
+		// Check for shadow blockers - use adaptive epsilon
+		if (current->t > adaptive_epsilon(current->t) && current->t < max_distance)
 		{
-			intersect_cone(&obj->shape.co, ray, &intersections, obj);
-		}
-		current = intersections;
-		while (current)
-		{
-			// Check for shadow blockers - use adaptive epsilon
-			if (current->t > adaptive_epsilon(current->t) && current->t < max_distance)
-			{
-				while (intersections)
-				{
-					temp = intersections->next;
-					free(intersections);
-					intersections = temp;
-				}
-				return (true);
-			}
-			current = current->next;
+			free_intersections(intersections);
+			return (true);
 		}
+		current = current->next;
+	}
+	free_intersections(intersections);
+	return (false);
+}
+
+bool	intersect_world_shadow(t_world world, t_ray ray, float max_distance)
+{
+	t_object	*obj;
+
+	obj = world.objects;
+	while (obj)
+	{
+		if (object_material(obj)->casts_shadow
+			&& blocks_shadow_ray(obj, ray, max_distance, world.stats))
+			return (true);
 		obj = obj->next;
 	}
-	while (intersections)
+	return (false);
+}
+
+bool	intersect_occluders(t_object **occluders, t_ray ray, float max_distance,
+		t_ray_stats *stats)
+{
+	while (*occluders)
 	{
-		temp = intersections->next;
-		free(intersections);
-		intersections = temp;
+		if (blocks_shadow_ray(*occluders, ray, max_distance, stats))
+			return (true);
+		occluders++;
 	}
 	return (false);
 }
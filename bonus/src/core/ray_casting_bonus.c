@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2025/12/09 10:29:46 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 23:14:54 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -36,29 +36,134 @@ static t_inters	*find_hit_intersection(t_inters *intersections, float hit_t)
 	return (hit_i);
 }
 
-t_tuple	color_at(t_world world, t_ray ray, int depth)
+/*
+** Nearest hit of `ray` with its hit record filled in; false on a miss.
+*/
+bool	first_hit(t_world *world, t_ray ray, t_comps *comps)
 {
 	t_inters	*intersections;
 	float		hit_t;
 	t_inters	*hit_i;
-	t_comps		*comp;
-	t_tuple		color;
 
-	if (depth <= 0)
-		return ((t_tuple){0, 0, 0, 0});
-	intersections = intersect_world(world, ray);
+	intersections = intersect_world(*world, ray);
 	if (!intersections)
-		return ((t_tuple){0, 0, 0, 0});
+		return (false);
 	hit_t = hit(intersections);
 	if (hit_t < 0)
 	{
 		cleanup_intersections(intersections);
-		return ((t_tuple){0, 0, 0, 0});
+		return (false);
 	}
 	hit_i = find_hit_intersection(intersections, hit_t);
-	comp = prepare_computations(hit_i, ray, intersections);
-	color = shade_hit(world, comp, depth);
-	free(comp);
+	prepare_computations(hit_i, ray, intersections, comps);
 	cleanup_intersections(intersections);
-	return (color);
+	return (true);
+}
+
+static void	enter_frame(t_world *world, t_trace_frame *frame, float weight, \
+	int depth)
+{
+	frame->surface = shade_surface(world, &frame->comps);
+	frame->refracted = (t_tuple){0, 0, 0, 0};
+	frame->reflected = (t_tuple){0, 0, 0, 0};
+	frame->weight = weight;
+	frame->scale = 0.0f;
+	frame->reflectance = 1.0;
+	frame->depth = depth;
+	frame->stage = TRACE_REFRACT;
+	frame->traced_refract = false;
+	frame->traced_reflect = false;
+}
+
+static bool	trace_enter(t_world *world, t_trace_frame *frame, t_bounce bounce, \
+	int depth)
+{
+	if (depth <= 0 || !first_hit(world, bounce.ray, &frame->comps))
+		return (false);
+	enter_frame(world, frame, bounce.weight, depth);
+	return (true);
+}
+
+static void	trace_return(t_trace_frame *frame, t_tuple color)
+{
+	if (frame->stage == TRACE_REFRACT)
+		frame->refracted = tuple_scalar_mult(color, frame->scale);
+	else
+		frame->reflected = tuple_scalar_mult(color, frame->scale);
+	frame->stage++;
+}
+
+/*
+** Iterative ray evaluation. Each hit gets a frame on a fixed stack (one per
+** bounce level, so MAX_REFLECTION_DEPTH deep), walked through its stages:
+** trace the refracted ray, trace the reflected ray, blend. A child frame
+** returns its colour into the parent's slot, scaled by the bounce factor.
+** Hit records live in the frames, so no t_comps is allocated per bounce.
+*/
+static t_tuple	unwind(t_world *world, t_trace_frame *stack)
+{
+	t_trace_frame	*frame;
+	t_bounce		next;
+	t_tuple			color;
+	int				top;
+
+	top = 0;
+	if (world->stats && world->stats->depth < 1)
+		world->stats->depth = 1;
+	while (1)
+	{
+		frame = &stack[top];
+		if (frame->stage != TRACE_BLEND)
+		{
+			if (shade_next_bounce(world, frame, &next) && trace_enter(world,
+					&stack[top + 1], next, frame->depth - 1))
+			{
+				frame->scale = next.scale;
+				top++;
+				if (world->stats && world->stats->depth < (uint32_t)top + 1)
+					world->stats->depth = top + 1;
+			}
+			else
+				frame->stage++;
+			continue ;
+		}
+		color = shade_blend(frame);
+		if (top-- == 0)
+			return (color);
+		trace_return(&stack[top], color);
+	}
+}
+
+/*
+** world.primary, the tile's visible set, only applies to the first ray.
+*/
+t_tuple	color_at(t_world world, t_ray ray, int depth, float weight)
+{
+	t_trace_frame	stack[MAX_REFLECTION_DEPTH];
+
+	if (depth > MAX_REFLECTION_DEPTH)
+		depth = MAX_REFLECTION_DEPTH;
+	if (!trace_enter(&world, &stack[0], (t_bounce){ray, weight, 1.0f}, depth))
+		return ((t_tuple){0, 0, 0, 0});
+	world.primary = NULL;
+	return (unwind(&world, stack));
+}
+
+/*
+** Same as color_at for a ray whose first hit is already known (a G-buffer
+** record): shading, shadows and secondary rays run, the first
+** intersection test does not.
+*/
+t_tuple	color_from_hit(t_world world, t_comps *comps, int depth, float weight)
+{
+	t_trace_frame	stack[MAX_REFLECTION_DEPTH];
+
+	if (depth > MAX_REFLECTION_DEPTH)
+		depth = MAX_REFLECTION_DEPTH;
+	if (depth <= 0)
+		return ((t_tuple){0, 0, 0, 0});
+	world.primary = NULL;
+	stack[0].comps = *comps;
+	enter_frame(&world, &stack[0], weight, depth);
+	return (unwind(&world, stack));
 }
@@ -0,0 +1,76 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ray_termination_bonus.c                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 09:07:13 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 09:07:13 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+/*
+** Stateless per-ray random number in [0, 1): hashes the ray itself so the
+** roulette is thread-safe and a given frame always renders the same way.
+*/
+static float	ray_random(t_ray ray, int depth)
+{
+	uint32_t	bits[6];
+	uint32_t	h;
+	int			i;
+
+	ft_memcpy(&bits[0], &ray.origin.x, sizeof(float));
+	ft_memcpy(&bits[1], &ray.origin.y, sizeof(float));
+	ft_memcpy(&bits[2], &ray.origin.z, sizeof(float));
+	ft_memcpy(&bits[3], &ray.direction.x, sizeof(float));
+	ft_memcpy(&bits[4], &ray.direction.y, sizeof(float));
+	ft_memcpy(&bits[5], &ray.direction.z, sizeof(float));
+	h = 2166136261u ^ (uint32_t)depth;
+	i = 0;
+	while (i < 6)
+	{
+		h = (h ^ bits[i]) * 16777619u;
+		h ^= h >> 15;
+		i++;
+	}
+	h *= 0x2c1b3c6du;
+	h ^= h >> 12;
+	return ((h >> 8) * (1.0f / 16777216.0f));
+}
+
+/*
+** True when a ray carrying `weight` is not traced in full: either dropped
+** by the cutoff or handed to the Russian roulette.
+*/
+bool	path_below_threshold(t_world *world, float weight)
+{
+	if (world->trace.russian_roulette)
+		return (weight < RR_WEIGHT);
+	return (weight < world->trace.min_weight);
+}
+
+/*
+** Decides whether a secondary ray carrying `weight` (its maximum share of
+** the final pixel) is worth tracing. Returns the factor its colour must be
+** scaled by: 0 when the ray is dropped, 1 when it is traced as usual and
+** 1/p when it survived Russian roulette with probability p, which keeps
+** the estimate unbiased.
+*/
+float	path_survival(t_world *world, t_ray ray, int depth, float weight)
+{
+	float	p;
+
+	if (weight <= 0.0f)
+		return (0.0f);
+	if (!path_below_threshold(world, weight))
+		return (1.0f);
+	if (!world->trace.russian_roulette)
+		return (0.0f);
+	p = weight / RR_WEIGHT;
+	if (ray_random(ray, depth) >= p)
+		return (0.0f);
+	return (1.0f / p);
+}
@@ -6,129 +6,88 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/09 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 07:16:17 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 07:36:44 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "../../includes/miniRT_bonus.h"
 
-typedef struct s_container
+/*
+** Open containers, innermost last. Instances of one prototype share their
+** member objects, so a container is the object and the instance it was
+** entered through.
+*/
+typedef struct s_containers
 {
-	t_object			*obj;
-	struct s_container	*next;
-}	t_container;
+	t_object	*objs[MAX_CONTAINERS];
+	t_instance	*insts[MAX_CONTAINERS];
+	int			count;
+}	t_containers;
 
-static void	add_container(t_container **list, t_object *obj)
+static void	drop_container(t_containers *list, int i)
 {
-	t_container	*new;
-	t_container	*tmp;
-
-	new = malloc(sizeof(t_container));
-	if (!new)
-		return ;
-	new->obj = obj;
-	new->next = NULL;
-	if (!*list)
-		*list = new;
-	else
-	{
-		tmp = *list;
-		while (tmp->next)
-			tmp = tmp->next;
-		tmp->next = new;
-	}
+	ft_memmove(&list->objs[i], &list->objs[i + 1],
+		(list->count - i - 1) * sizeof(t_object *));
+	ft_memmove(&list->insts[i], &list->insts[i + 1],
+		(list->count - i - 1) * sizeof(t_instance *));
+	list->count--;
 }
 
-static bool	remove_container(t_container **list, t_object *obj)
+/*
+** Enters the container x crosses if it is not open yet, leaves it
+** otherwise. When the array is full the outermost container is forgotten:
+** only the innermost one decides the refractive index, and a ray that deep
+** is inside its own geometry soup.
+*/
+static void	toggle_container(t_containers *list, t_inters *x)
 {
-	t_container	*tmp;
-	t_container	*prev;
+	int	i;
 
-	if (!*list)
-		return (false);
-	if ((*list)->obj == obj)
+	i = list->count;
+	while (--i >= 0)
 	{
-		tmp = *list;
-		*list = (*list)->next;
-		free(tmp);
-		return (true);
-	}
-	prev = *list;
-	tmp = (*list)->next;
-	while (tmp)
-	{
-		if (tmp->obj == obj)
+		if (list->objs[i] == x->object && list->insts[i] == x->inst)
 		{
-			prev->next = tmp->next;
-			free(tmp);
-			return (true);
+			drop_container(list, i);
+			return ;
 		}
-		prev = tmp;
-		tmp = tmp->next;
 	}
-	return (false);
+	if (list->count == MAX_CONTAINERS)
+		drop_container(list, 0);
+	list->objs[list->count] = x->object;
+	list->insts[list->count++] = x->inst;
 }
 
-static float	get_last_refractive_index(t_container *list)
+static float	get_last_refractive_index(t_containers *list)
 {
-	t_container	*tmp;
-	float		index;
-
-	if (!list)
+	if (list->count == 0)
 		return (1.0);
-	tmp = list;
-	index = 1.0;
-	while (tmp)
-	{
-		if (tmp->obj->type == OBJ_SPHERE)
-			index = tmp->obj->shape.sp.material.refract_index;
-		else if (tmp->obj->type == OBJ_PLANE)
-			index = tmp->obj->shape.pl.material.refract_index;
-		else if (tmp->obj->type == OBJ_CYLINDER)
-			index = tmp->obj->shape.cy.material.refract_index;
-		else if (tmp->obj->type == OBJ_CONE)
-			index = tmp->obj->shape.co.material.refract_index;
-		if (!tmp->next)
-			break ;
-		tmp = tmp->next;
-	}
-	return (index);
-}
-
-static void	free_containers(t_container *list)
-{
-	t_container	*tmp;
-
-	while (list)
-	{
-		tmp = list;
-		list = list->next;
-		free(tmp);
-	}
+	return (object_material(list->objs[list->count - 1])->refract_index);
 }
 
+/*
+** n1/n2 only feed refracted_ray and schlick, which both require a
+** transparent hit, so opaque hits keep the 1.0 defaults and skip the walk.
+*/
 void	compute_n1_n2(t_inters *hit, t_inters *xs, t_comps *comps)
 {
-	t_container	*containers;
-	t_inters	*current;
+	t_containers	containers;
+	t_inters		*current;
 
-	containers = NULL;
+	if (object_material(hit->object)->transparency <= 0.0)
+		return ;
+	containers.count = 0;
 	current = xs;
 	while (current)
 	{
 		if (current == hit)
-			comps->n1 = get_last_refractive_index(containers);
-		if (remove_container(&containers, current->object))
-			;
-		else
-			add_container(&containers, current->object);
+			comps->n1 = get_last_refractive_index(&containers);
+		toggle_container(&containers, current);
 		if (current == hit)
 		{
-			comps->n2 = get_last_refractive_index(containers);
-			free_containers(containers);
+			comps->n2 = get_last_refractive_index(&containers);
 			return ;
 		}
 		current = current->next;
 	}
-	free_containers(containers);
 }
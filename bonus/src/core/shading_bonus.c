@@ -6,135 +6,58 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 07:16:17 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 23:07:41 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "../../includes/miniRT_bonus.h"
 
-bool	is_shadowed(t_world world, t_tuple point, t_light *light)
+/*
+** Whether something stands between point and target, a point on light.
+** Occluder lists only hold scene objects; instances are always tested,
+** through their BVH, once no scene object blocks the ray.
+*/
+bool	shadowed_from(t_world world, t_tuple point, t_tuple target,
+	t_light *light)
 {
 	t_tuple		v;
 	float		distance;
 	t_tuple		direction;
 	t_ray		shadow_ray;
+	bool		blocked;
 
-	v = substract_tuple(light->origin, point);
+	v = substract_tuple(target, point);
 	distance = vector_magnitude(v);
 	direction = normalizing_vector(v);
 	shadow_ray = (t_ray){point, direction};
-	return (intersect_world_shadow(world, shadow_ray, distance));
-}
-
-static t_tuple	get_material_contribution(t_comps *comp, t_light *light, \
-				bool in_shadow, t_tuple ambient_color)
-{
-	t_tuple		point;
-	t_material	mat;
-
-	point = comp->point;
-	if (comp->obj->type == OBJ_SPHERE)
-	{
-		point = multiply_matrix_by_tuple(
-			comp->obj->shape.sp.trans_inv, comp->point);
-		mat = comp->obj->shape.sp.material;
-		if (mat.has_color_texture && mat.color_texture != NULL)
-			mat.color = (t_tuple){1, 1, 1, 0};
-		return (lighting(mat, *light, point, \
-			comp->eyev, comp->normalv, in_shadow, ambient_color));
-	}
-	else if (comp->obj->type == OBJ_PLANE)
-	{
-		point = multiply_matrix_by_tuple(
-			comp->obj->shape.pl.trans_inv, comp->point);
-		mat = comp->obj->shape.pl.material;
-		if (mat.has_color_texture && mat.color_texture != NULL)
-			mat.color = (t_tuple){1, 1, 1, 0};
-		return (lighting(mat, *light, point, \
-			comp->eyev, comp->normalv, in_shadow, ambient_color));
-	}
-	else if (comp->obj->type == OBJ_CYLINDER)
-	{
-		point = multiply_matrix_by_tuple(comp->obj->shape.cy.trans_inv, comp->point);
-		mat = comp->obj->shape.cy.material;
-		if (mat.has_color_texture && mat.color_texture != NULL)
-			mat.color = (t_tuple){1, 1, 1, 0};
-		return (lighting(mat, *light, point, \
-			comp->eyev, comp->normalv, in_shadow, ambient_color));
-	}
-	else if (comp->obj->type == OBJ_CONE)
-	{
-		point = multiply_matrix_by_tuple(comp->obj->shape.co.trans_inv, comp->point);
-		mat = comp->obj->shape.co.material;
-		if (mat.has_color_texture && mat.color_texture != NULL)
-			mat.color = (t_tuple){1, 1, 1, 0};
-		return (lighting(mat, *light, point, \
-			comp->eyev, comp->normalv, in_shadow, ambient_color));
-	}
-	return ((t_tuple){0, 0, 0, 0});
+	if (world.stats)
+		world.stats->shadow_rays++;
+	if (light->occluders)
+		blocked = intersect_occluders(light->occluders, shadow_ray, distance,
+				world.stats);
+	else
+		blocked = intersect_world_shadow(world, shadow_ray, distance);
+	return (blocked || instances_occlude(world.instances, shadow_ray,
+			distance, world.stats));
 }
 
-t_tuple reflected_color(t_world world, t_comps *comps, int depth);
-t_tuple refracted_color(t_world world, t_comps *comps, int depth);
-
-static t_tuple	get_ambient_contribution(t_comps *comp, t_tuple ambient_color)
+bool	is_shadowed(t_world world, t_tuple point, t_light *light)
 {
-	t_material	mat;
-	t_tuple		color_at_point;
-	t_tuple		pos;
-
-	if (comp->obj->type == OBJ_SPHERE)
-		mat = comp->obj->shape.sp.material;
-	else if (comp->obj->type == OBJ_PLANE)
-		mat = comp->obj->shape.pl.material;
-	else if (comp->obj->type == OBJ_CYLINDER)
-		mat = comp->obj->shape.cy.material;
-	else if (comp->obj->type == OBJ_CONE)
-		mat = comp->obj->shape.co.material;
-	else
-		return ((t_tuple){0, 0, 0, 0});
-	
-	// Use white for textured objects, texture color applied later in shade_hit
-	if (mat.has_color_texture && mat.color_texture != NULL)
-		color_at_point = (t_tuple){1, 1, 1, 0};
-	else
-		color_at_point = mat.color;
-	
-	// Apply pattern if present (for non-textured objects)
-	if (mat.pattern.at != NULL)
-	{
-		pos = comp->point;
-		if (comp->obj->type == OBJ_SPHERE)
-			pos = multiply_matrix_by_tuple(inverse_matrix( \
-				comp->obj->shape.sp.trans), pos);
-		else if (comp->obj->type == OBJ_PLANE)
-			pos = multiply_matrix_by_tuple(inverse_matrix( \
-				comp->obj->shape.pl.trans), pos);
-		else if (comp->obj->type == OBJ_CYLINDER)
-			pos = multiply_matrix_by_tuple(inverse_matrix( \
-				comp->obj->shape.cy.trans), pos);
-		else if (comp->obj->type == OBJ_CONE)
-			pos = multiply_matrix_by_tuple(inverse_matrix( \
-				comp->obj->shape.co.trans), pos);
-		if (mat.pattern.has_transform)
-			pos = multiply_matrix_by_tuple(mat.pattern.inv_transform, pos);
-		color_at_point = mat.pattern.at(mat.pattern, pos);
-	}
-	return (hadamard_product(tuple_scalar_mult(color_at_point, mat.ambient), \
-		ambient_color));
+	return (shadowed_from(world, point, light->origin, light));
 }
 
-static float	get_object_transparency(t_comps *comp)
+/*
+** The colour the lights see at the hit: the pattern's, else white under a
+** colour texture (shade_surface multiplies the texel in afterwards), else
+** the material's.
+*/
+static t_tuple	surface_color(t_material *mat, t_tuple local_point)
 {
-	if (comp->obj->type == OBJ_SPHERE)
-		return (comp->obj->shape.sp.material.transparency);
-	else if (comp->obj->type == OBJ_PLANE)
-		return (comp->obj->shape.pl.material.transparency);
-	else if (comp->obj->type == OBJ_CYLINDER)
-		return (comp->obj->shape.cy.material.transparency);
-	else if (comp->obj->type == OBJ_CONE)
-		return (comp->obj->shape.co.material.transparency);
-	return (0.0);
+	if (mat->pattern.at != NULL)
+		return (pattern_color(&mat->pattern, local_point));
+	if (mat->has_color_texture && mat->color_texture != NULL)
+		return ((t_tuple){1, 1, 1, 0});
+	return (mat->color);
 }
 
 static float	schlick(t_comps *comps)
@@ -144,6 +67,8 @@ static float	schlick(t_comps *comps)
 	float	sin2_t;
 	float	cos_t;
 	float	r0;
+	float	x;
+	float	x2;
 
 	cos = vecs_dot_product(comps->eyev, comps->normalv);
 	if (comps->n1 > comps->n2)
@@ -157,101 +82,104 @@ static float	schlick(t_comps *comps)
 	}
 	r0 = ((comps->n1 - comps->n2) / (comps->n1 + comps->n2));
 	r0 = r0 * r0;
-	return (r0 + (1.0 - r0) * powf((1.0 - cos), 5));
+	x = 1.0f - cos;
+	x2 = x * x;
+	return (r0 + (1.0f - r0) * (x2 * x2 * x));
 }
 
-t_tuple	shade_hit(t_world world, t_comps *comp, int depth)
+/*
+** What one light adds at the hit, its brightness scaled by scale (falloff,
+** or the weight of a sampled light) and by how much of it the hit sees.
+*/
+t_tuple	shade_light(t_world *world, t_comps *comp, t_light *light, float scale)
 {
-	t_tuple	surface;
-	t_tuple	opaque_surface;
-	t_tuple	reflected;
-	t_tuple	refracted;
-	t_light	*light;
-	bool	in_shadow;
-	t_tuple	light_contrib;
-	float	transparency;
-	float	reflectance;
-	t_material mat;
-	t_tuple texture_color;
-	t_tuple pos;
-	t_tuple uv;
+	t_light	lit;
+	float	visible;
 
-	// Initialize mat with default values to prevent undefined behavior
-	mat = material();
-	mat.has_color_texture = false;
-	mat.color_texture = NULL;
+	visible = 1.0f;
+	if (object_material(comp->obj)->receives_shadow)
+		visible = light_visibility(world, comp->over_point, light);
+	lit = *light;
+	lit.brightness *= scale * visible;
+	return (lighting(object_material(comp->obj), &lit, comp,
+			visible <= 0.0f));
+}
 
-	// Get texture color if available
-	texture_color = (t_tuple){1, 1, 1, 0};  // White by default (no texture)
-	if (comp->obj->type == OBJ_SPHERE)
-		mat = comp->obj->shape.sp.material;
-	else if (comp->obj->type == OBJ_PLANE)
-		mat = comp->obj->shape.pl.material;
-	else if (comp->obj->type == OBJ_CYLINDER)
-		mat = comp->obj->shape.cy.material;
-	else if (comp->obj->type == OBJ_CONE)
-		mat = comp->obj->shape.co.material;
-	
-	// Sample texture if present
-	if (mat.has_color_texture && mat.color_texture != NULL)
-	{
-		pos = comp->point;
-		if (comp->obj->type == OBJ_SPHERE)
-		{
-			pos = multiply_matrix_by_tuple(inverse_matrix( \
-				comp->obj->shape.sp.trans), pos);
-			uv = sphere_uv_mapping(pos);
-		}
-		else if (comp->obj->type == OBJ_PLANE)
-		{
-			pos = multiply_matrix_by_tuple(inverse_matrix( \
-				comp->obj->shape.pl.trans), pos);
-			uv = plane_uv_mapping(pos);
-		}
-		else if (comp->obj->type == OBJ_CYLINDER)
-		{
-			pos = multiply_matrix_by_tuple(inverse_matrix( \
-				comp->obj->shape.cy.trans), pos);
-			uv = cylinder_uv_mapping(pos);
-		}
-		else if (comp->obj->type == OBJ_CONE)
-		{
-			pos = multiply_matrix_by_tuple(inverse_matrix( \
-				comp->obj->shape.co.trans), pos);
-			uv = cone_uv_mapping(pos);
-		}
-		texture_color = sample_color_from_texture(mat.color_texture, uv.x, uv.y);
-	}
+/*
+** Local (direct) part of the hit colour: ambient plus the lights, modulated
+** by the texture and weighted by how opaque the surface is. Reflected and
+** refracted light is added by shade_blend once color_at has traced them.
+** The surface colour is looked up here, once, for the ambient term and
+** every light.
+*/
+t_tuple	shade_surface(t_world *world, t_comps *comp)
+{
+	t_tuple		opaque_surface;
+	t_tuple		texture_color;
+	t_material	*mat;
 
-	opaque_surface = get_ambient_contribution(comp, world.ambient_color);
-	light = world.lights;
-	while (light)
-	{
-		in_shadow = is_shadowed(world, comp->over_point, light);
-		light_contrib = get_material_contribution(comp, light, \
-			in_shadow, (t_tuple){0, 0, 0, 0});
-		opaque_surface = add_tuple(opaque_surface, light_contrib);
-		light = light->next;
-	}
-	// Apply texture color to the final lit surface
+	mat = object_material(comp->obj);
+	comp->local_point = comps_local_point(comp);
+	comp->color = surface_color(mat, comp->local_point);
+	texture_color = (t_tuple){1, 1, 1, 0};
+	if (mat->has_color_texture && mat->color_texture != NULL)
+		texture_color = sample_color_from_texture(mat->color_texture,
+				comp->uv.x, comp->uv.y);
+	opaque_surface = direct_lighting(world, comp, hadamard_product(
+				tuple_scalar_mult(comp->color, mat->ambient),
+				world->ambient_color));
 	// Pure hadamard product: modulates lighting by texture color
 	opaque_surface = hadamard_product(opaque_surface, texture_color);
-	transparency = get_object_transparency(comp);
-	surface = tuple_scalar_mult(opaque_surface, 1.0 - transparency);
-	reflected = reflected_color(world, comp, depth);
-	refracted = refracted_color(world, comp, depth);
-	if (reflected.x > 0.0 && refracted.x > 0.0)
-	{
-		reflectance = schlick(comp);
-		surface = add_tuple(surface, tuple_scalar_mult(reflected, reflectance));
-		surface = add_tuple(surface, tuple_scalar_mult(refracted, \
-			(1.0 - reflectance)));
-	}
-	else
+	return (tuple_scalar_mult(opaque_surface, 1.0 - mat->transparency));
+}
+
+/*
+** Builds the next secondary ray of a frame: refraction first, then the
+** reflection, weighted by the Schlick share when the material both
+** refracts and reflects. Records which rays were cast for shade_blend;
+** returns false when the current stage spawns nothing.
+*/
+bool	shade_next_bounce(t_world *world, t_trace_frame *frame, t_bounce *next)
+{
+	t_material	*mat;
+
+	if (frame->stage == TRACE_REFRACT)
 	{
-		surface = add_tuple(surface, reflected);
-		surface = add_tuple(surface, refracted);
+		frame->traced_refract = frame->depth > 1 && refracted_ray(world,
+				&frame->comps, frame->depth, frame->weight, next);
+		return (frame->traced_refract);
 	}
+	mat = object_material(frame->comps.obj);
+	if (mat->transparency > 0.0 && mat->reflective > 0.0)
+		frame->reflectance = schlick(&frame->comps);
+	frame->traced_reflect = frame->depth > 1 && reflected_ray(world,
+			&frame->comps, frame->depth, frame->weight * frame->reflectance,
+			next);
+	return (frame->traced_reflect);
+}
+
+/*
+** Adds the rays shade_next_bounce cast, never guessing from their colours.
+** A material that both refracts and reflects splits them by Fresnel:
+** reflectance was 1 for every other material.
+*/
+t_tuple	shade_blend(t_trace_frame *frame)
+{
+	t_tuple		surface;
+	t_material	*mat;
+	float		transmittance;
+
+	surface = frame->surface;
+	mat = object_material(frame->comps.obj);
+	transmittance = 1.0;
+	if (mat->transparency > 0.0 && mat->reflective > 0.0)
+		transmittance = 1.0 - frame->reflectance;
+	if (frame->traced_reflect)
+		surface = add_tuple(surface, \
+			tuple_scalar_mult(frame->reflected, frame->reflectance));
+	if (frame->traced_refract)
+		surface = add_tuple(surface, \
+			tuple_scalar_mult(frame->refracted, transmittance));
 	surface.w = 0;
 	return (surface);
 }
@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2025/12/15 01:26:27 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 20:21:42 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -17,68 +17,131 @@ t_world	new_world(void)
 	t_world	world;
 
 	world.objects = NULL;
+	world.primary = NULL;
+	world.instances = NULL;
 	world.lights = NULL;
+	world.light_tree = NULL;
 	world.ambient_color = (t_tuple){1, 1, 1, 0};
+	world.trace.min_weight = MIN_RAY_WEIGHT;
+	world.trace.russian_roulette = false;
+	world.trace.light_cutoff = 0.0f;
+	world.trace.light_samples = 0;
+	world.stats = NULL;
 	return (world);
 }
 
-t_object	*new_object(t_obj_type type, t_shapes shape)
+t_object	*new_object(t_arena *arena, t_obj_type type, t_shapes shape)
 {
 	t_object	*obj;
 
-	obj = malloc(sizeof(t_object));
+	obj = arena_alloc(arena, sizeof(t_object));
 	if (!obj)
 		return (NULL);
 	obj->type = type;
 	obj->shape = shape;
+	obj->bounds = object_bounds(obj);
 	obj->next = NULL;
 	return (obj);
 }
 
-void	ft_add_object(t_object **lst, t_object *new)
+t_material	*object_material(t_object *obj)
 {
-	t_object	*ptr;
+	if (obj->type == OBJ_SPHERE)
+		return (&obj->shape.sp.material);
+	else if (obj->type == OBJ_PLANE)
+		return (&obj->shape.pl.material);
+	else if (obj->type == OBJ_CYLINDER)
+		return (&obj->shape.cy.material);
+	else if (obj->type == OBJ_CONE)
+		return (&obj->shape.co.material);
+	else if (obj->type == OBJ_MESH)
+		return (&obj->shape.me.material);
+	return (NULL);
+}
+
+/*
+** Where an object keeps its object-to-world matrix and its inverse.
+*/
+void	object_transforms(t_object *obj, t_matrix **trans, t_matrix **inv)
+{
+	*trans = &obj->shape.sp.trans;
+	*inv = &obj->shape.sp.trans_inv;
+	if (obj->type == OBJ_PLANE)
+	{
+		*trans = &obj->shape.pl.trans;
+		*inv = &obj->shape.pl.trans_inv;
+	}
+	else if (obj->type == OBJ_CYLINDER)
+	{
+		*trans = &obj->shape.cy.trans;
+		*inv = &obj->shape.cy.trans_inv;
+	}
+	else if (obj->type == OBJ_CONE)
+	{
+		*trans = &obj->shape.co.trans;
+		*inv = &obj->shape.co.trans_inv;
+	}
+	else if (obj->type == OBJ_MESH)
+	{
+		*trans = &obj->shape.me.trans;
+		*inv = &obj->shape.me.trans_inv;
+	}
+}
 
+/*
+** Appends in O(1): *last is the list's final node, kept by the caller.
+** A NULL or stale one is found again by walking on from where it points.
+*/
+void	ft_add_object(t_object **lst, t_object **last, t_object *new)
+{
 	if (!new || !lst)
 		return ;
 	if (!*lst)
-	{
 		*lst = new;
-		return ;
+	else
+	{
+		if (!*last)
+			*last = *lst;
+		while ((*last)->next)
+			*last = (*last)->next;
+		(*last)->next = new;
 	}
-	ptr = *lst;
-	while (ptr->next)
-		ptr = ptr->next;
-	ptr->next = new;
+	*last = new;
 }
 
-t_light	*new_light(t_tuple point, t_tuple color)
+t_light	*new_light(t_arena *arena, t_tuple point, t_tuple color)
 {
 	t_light	*light;
 
-	light = malloc(sizeof(t_light));
+	light = arena_alloc(arena, sizeof(t_light));
 	if (!light)
 		return (NULL);
 	light->origin = point;
 	light->color = color;
 	light->brightness = 1.0;
+	light->range = 0.0f;
+	light->kind = LIGHT_POINT;
+	light->u = (t_tuple){0, 0, 0, 0};
+	light->v = (t_tuple){0, 0, 0, 0};
+	light->radius = 0.0f;
+	light->occluders = NULL;
 	light->next = NULL;
 	return (light);
 }
 
-void	ft_add_light(t_light **lst, t_light *new)
+void	ft_add_light(t_light **lst, t_light **last, t_light *new)
 {
-	t_light	*ptr;
-
 	if (!new || !lst)
 		return ;
 	if (!*lst)
-	{
 		*lst = new;
-		return ;
+	else
+	{
+		if (!*last)
+			*last = *lst;
+		while ((*last)->next)
+			*last = (*last)->next;
+		(*last)->next = new;
 	}
-	ptr = *lst;
-	while (ptr->next)
-		ptr = ptr->next;
-	ptr->next = new;
+	*last = new;
 }
@@ -0,0 +1,247 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   coordinator_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:39:11 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 00:05:25 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+
+/*
+** Without --listen the coordinator and its local workers meet on a private
+** Unix socket named after the coordinator's pid.
+*/
+static bool	open_listener(t_coordinator *co)
+{
+	char	*pid;
+
+	co->address = co->opts->listen;
+	if (!co->address)
+	{
+		pid = ft_itoa(getpid());
+		if (pid)
+			co->own_socket = ft_strjoin("/tmp/minirt_", pid);
+		free(pid);
+		if (!co->own_socket)
+			return (false);
+		unlink(co->own_socket);
+		co->address = co->own_socket;
+	}
+	co->listen_fd = net_listen(co->address);
+	return (co->listen_fd >= 0);
+}
+
+/*
+** Local workers are forked children running the same worker loop a remote
+** `--worker <addr>` process would, over the same socket protocol.
+*/
+static bool	spawn_workers(t_coordinator *co, t_data *data)
+{
+	t_options	opts;
+	pid_t		pid;
+
+	fflush(stdout);
+	while (co->child_count < co->opts->workers)
+	{
+		pid = fork();
+		if (pid < 0)
+			return (perror("fork"), false);
+		if (pid == 0)
+		{
+			prof_fork();
+			close(co->listen_fd);
+			opts = *co->opts;
+			opts.worker = co->address;
+			free_objects_and_lights(data);
+			exit(run_worker(&opts));
+		}
+		co->children[co->child_count++] = pid;
+	}
+	return (true);
+}
+
+static void	assign_tiles(t_coordinator *co)
+{
+	t_tile	tile;
+	int		i;
+
+	i = co->peer_count;
+	while (--i >= 0)
+	{
+		if (!co->peers[i].ready || co->peers[i].tile >= 0)
+			continue ;
+		while (co->cursor < co->total_tiles
+			&& co->tiles[co->cursor] != TILE_PENDING)
+			co->cursor++;
+		if (co->cursor == co->total_tiles)
+			return ;
+		tile = region_tile(co->region, co->cursor);
+		if (!net_send(co->peers[i].fd, MSG_TILE, &tile, sizeof(tile)))
+		{
+			drop_peer(co, i, "connection lost");
+			continue ;
+		}
+		co->tiles[co->cursor] = TILE_ASSIGNED;
+		co->peers[i].tile = co->cursor;
+		co->peers[i].deadline = net_clock() + co->opts->tile_timeout;
+	}
+}
+
+/*
+** One round of the event loop: hand out work, wait for results, retire
+** workers that blew their deadline (for READY, or for their tile). Peers
+** are walked from the end so a drop (which moves the last peer into the
+** hole) never skips anyone.
+*/
+static void	poll_round(t_coordinator *co)
+{
+	struct pollfd	fds[MAX_WORKERS + 1];
+	int				count;
+	int				i;
+
+	assign_tiles(co);
+	count = co->peer_count;
+	i = -1;
+	while (++i < count)
+		fds[i] = (struct pollfd){co->peers[i].fd, POLLIN, 0};
+	fds[count] = (struct pollfd){co->listen_fd, POLLIN, 0};
+	if (poll(fds, count + 1, POLL_INTERVAL) < 0)
+		return ;
+	while (--i >= 0)
+	{
+		if (fds[i].revents)
+			receive_from_peer(co, i);
+		else if (net_clock() <= co->peers[i].deadline)
+			continue ;
+		else if (!co->peers[i].ready)
+			drop_peer(co, i, "never became ready");
+		else if (co->peers[i].tile >= 0)
+			drop_peer(co, i, "timed out");
+	}
+	if (fds[count].revents & POLLIN)
+		accept_peer(co);
+}
+
+/*
+** Local children are reaped as they exit; with no --listen address nobody
+** else can join, so losing all of them ends the render.
+*/
+static bool	workers_left(t_coordinator *co)
+{
+	int	status;
+	int	i;
+
+	i = 0;
+	while (i < co->child_count)
+	{
+		if (co->children[i] > 0
+			&& waitpid(co->children[i], &status, WNOHANG) == co->children[i])
+			co->children[i] = 0;
+		i++;
+	}
+	if (co->peer_count > 0 || co->opts->listen)
+		return (true);
+	i = 0;
+	while (i < co->child_count)
+	{
+		if (co->children[i] > 0)
+			return (true);
+		i++;
+	}
+	return (false);
+}
+
+static void	shutdown_workers(t_coordinator *co)
+{
+	int	i;
+
+	while (co->peer_count > 0)
+	{
+		net_send(co->peers[co->peer_count - 1].fd, MSG_DONE, NULL, 0);
+		close(co->peers[--co->peer_count].fd);
+	}
+	if (co->listen_fd >= 0)
+		close(co->listen_fd);
+	if (co->own_socket)
+		unlink(co->own_socket);
+	free(co->own_socket);
+	i = 0;
+	while (i < co->child_count)
+	{
+		if (co->children[i] > 0)
+			waitpid(co->children[i], NULL, 0);
+		i++;
+	}
+	free(co->tiles);
+}
+
+static bool	write_output(t_coordinator *co)
+{
+	char		*path;
+	char		*dot;
+	uint64_t	start;
+	bool		ok;
+
+	path = co->opts->output;
+	if (!path)
+		path = "render.ppm";
+	start = prof_now();
+	dot = ft_strrchr(path, '.');
+	if (dot && ft_strncmp(dot, ".pfm", 5) == 0)
+		ok = framebuffer_to_pfm(co->fb, path);
+	else
+		ok = framebuffer_to_ppm(co->fb, path);
+	prof_span("export", start, -1);
+	if (!ok)
+		return (printf("❌ Error: cannot write %s\n", path), false);
+	printf("💾 Saved %s\n", path);
+	return (true);
+}
+
+/*
+** Headless distributed render of the parsed scene: split the frame (or
+** just its --region) into TILE_SIZE tiles, farm them out to --workers
+** local processes and/or any worker that connects to --listen, stitch
+** results as they arrive and write the frame to --output.
+*/
+int	run_coordinator(t_data *data)
+{
+	t_coordinator	co;
+	double			start;
+	bool			ok;
+
+	co = (t_coordinator){.opts = &data->opts, .listen_fd = -1,
+		.fb = &data->fb};
+	job_region(&data->opts.job, &co.region);
+	co.total_tiles = region_tile_count(co.region);
+	co.tiles = ft_calloc(co.total_tiles, sizeof(*co.tiles));
+	ok = co.tiles && framebuffer_init(co.fb, data->opts.job.width,
+			data->opts.job.height) && open_listener(&co)
+		&& spawn_workers(&co, data) && coordinator_checkpoint_start(&co, data);
+	if (ok)
+		printf("🌐 Coordinator on %s: %d tiles, %d local workers\n",
+			co.address, co.total_tiles, co.child_count);
+	start = net_clock();
+	while (ok && co.tiles_done < co.total_tiles)
+	{
+		poll_round(&co);
+		if (!workers_left(&co))
+			ok = (printf("❌ Error: every worker was lost\n"), false);
+	}
+	if (ok)
+		printf("✅ %d tiles in %.3f s (%d reassigned)\n", co.total_tiles,
+			net_clock() - start, co.reassigned);
+	coordinator_checkpoint_stop(&co);
+	shutdown_workers(&co);
+	ok = ok && write_output(&co);
+	framebuffer_free(co.fb);
+	return (!ok);
+}
@@ -0,0 +1,88 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   coordinator_checkpoint_bonus.c                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 21:55:31 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 23:50:59 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+
+#include "../../includes/miniRT_bonus.h"
+
+/*
+** --checkpoint for a distributed render. Stitched tiles land in data->fb
+** and are marked in data->tile_done under render_mutex, so the local
+** render's key, loader and writer thread apply unchanged: the writer
+** copies the flags under the lock and reads the done tiles in place,
+** which nothing writes again. The poll loop never waits on the disk.
+*/
+bool	coordinator_checkpoint_start(t_coordinator *co, t_data *data)
+{
+	int	i;
+
+	if (!data->opts.checkpoint)
+		return (true);
+	data->region = co->region;
+	data->total_tiles = co->total_tiles;
+	data->tiles_done = 0;
+	data->tile_done = ft_calloc(co->total_tiles, 1);
+	if (!data->tile_done)
+		return (printf("❌ Error: cannot allocate tile list\n"), false);
+	co->ckpt = data;
+	if (!checkpoint_key(data, &data->ckpt.key))
+		return (printf("❌ Error: cannot fingerprint %s\n",
+				data->opts.scene), false);
+	if (data->opts.resume)
+		checkpoint_load(data);
+	i = 0;
+	while (i < co->total_tiles)
+	{
+		if (data->tile_done[i])
+			co->tiles[i] = TILE_DONE;
+		i++;
+	}
+	co->tiles_done = data->tiles_done;
+	pthread_mutex_init(&data->render_mutex, NULL);
+	data->mutex_initialized = true;
+	if (!checkpoint_start(data))
+		return (printf("❌ Error: cannot start checkpoint writer\n"), false);
+	return (true);
+}
+
+// Called once tile index is stitched into the framebuffer
+void	coordinator_checkpoint_tile(t_coordinator *co, int index)
+{
+	if (!co->ckpt)
+		return ;
+	pthread_mutex_lock(&co->ckpt->render_mutex);
+	co->ckpt->tile_done[index] = 1;
+	co->ckpt->tiles_done++;
+	pthread_mutex_unlock(&co->ckpt->render_mutex);
+}
+
+/*
+** Retires the writer, which saves a last checkpoint holding every
+** stitched tile whether the render completed or every worker was lost,
+** then releases whatever coordinator_checkpoint_start set up.
+*/
+void	coordinator_checkpoint_stop(t_coordinator *co)
+{
+	t_data	*data;
+
+	if (!co->ckpt)
+		return ;
+	data = co->ckpt;
+	co->ckpt = NULL;
+	checkpoint_stop(data);
+	if (data->mutex_initialized)
+	{
+		pthread_mutex_destroy(&data->render_mutex);
+		data->mutex_initialized = false;
+	}
+	free(data->tile_done);
+	data->tile_done = NULL;
+}
@@ -0,0 +1,131 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   net_bonus.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:10:19 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 14:10:19 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <time.h>
+
+/*
+** "host:port" is TCP, anything else (no colon, or a slash in it) is the
+** path of a Unix-domain socket. Fills *res for either family.
+*/
+static bool	resolve(char *address, bool passive, struct addrinfo **res)
+{
+	struct addrinfo	hints;
+	char			*colon;
+	char			*host;
+	int				err;
+
+	colon = ft_strrchr(address, ':');
+	if (!colon || ft_strchr(address, '/'))
+		return (*res = NULL, true);
+	ft_bzero(&hints, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	if (passive)
+		hints.ai_flags = AI_PASSIVE;
+	host = ft_substr(address, 0, colon - address);
+	if (!host)
+		return (false);
+	if (*host)
+		err = getaddrinfo(host, colon + 1, &hints, res);
+	else
+		err = getaddrinfo(NULL, colon + 1, &hints, res);
+	free(host);
+	if (err)
+		return (printf("❌ %s: %s\n", address, gai_strerror(err)), false);
+	return (true);
+}
+
+static int	unix_socket(char *path, bool server)
+{
+	struct sockaddr_un	sun;
+	int					fd;
+
+	if (ft_strlen(path) >= sizeof(sun.sun_path))
+		return (printf("❌ %s: socket path too long\n", path), -1);
+	ft_bzero(&sun, sizeof(sun));
+	sun.sun_family = AF_UNIX;
+	ft_memcpy(sun.sun_path, path, ft_strlen(path));
+	fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0)
+		return (-1);
+	if (server && (bind(fd, (struct sockaddr *)&sun, sizeof(sun)) < 0
+			|| listen(fd, MAX_WORKERS) < 0))
+		return (perror(path), close(fd), -1);
+	if (!server && connect(fd, (struct sockaddr *)&sun, sizeof(sun)) < 0)
+		return (perror(path), close(fd), -1);
+	return (fd);
+}
+
+int	net_listen(char *address)
+{
+	struct addrinfo	*res;
+	int				fd;
+	int				on;
+
+	if (!resolve(address, true, &res))
+		return (-1);
+	if (!res)
+		return (unix_socket(address, true));
+	on = 1;
+	fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+	if (fd >= 0 && (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on,
+				sizeof(on)) < 0 || bind(fd, res->ai_addr, res->ai_addrlen) < 0
+			|| listen(fd, MAX_WORKERS) < 0))
+	{
+		perror(address);
+		close(fd);
+		fd = -1;
+	}
+	freeaddrinfo(res);
+	return (fd);
+}
+
+int	net_connect(char *address)
+{
+	struct addrinfo	*res;
+	int				fd;
+
+	if (!resolve(address, false, &res))
+		return (-1);
+	if (!res)
+		return (unix_socket(address, false));
+	fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+	if (fd >= 0 && connect(fd, res->ai_addr, res->ai_addrlen) < 0)
+	{
+		perror(address);
+		close(fd);
+		fd = -1;
+	}
+	freeaddrinfo(res);
+	net_nodelay(fd);
+	return (fd);
+}
+
+/*
+** Messages go out as a header write followed by payload writes; without
+** TCP_NODELAY Nagle holds each tail back for the peer's delayed ACK and
+** a tile round trip costs ~40 ms. A no-op on Unix sockets.
+*/
+void	net_nodelay(int fd)
+{
+	int	on;
+
+	on = 1;
+	if (fd >= 0)
+		setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+}
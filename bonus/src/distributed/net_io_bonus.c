@@ -0,0 +1,70 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   net_io_bonus.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:17:32 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 14:17:32 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+#include <sys/socket.h>
+#include <time.h>
+
+/*
+** Messages are a t_msg_header followed by header.size payload bytes, in
+** host byte order: coordinator and workers are expected to run the same
+** build on the same architecture. net_send with a NULL payload only sends
+** the header and leaves the caller to stream the size bytes after it.
+*/
+bool	net_write(int fd, void *buf, size_t size)
+{
+	ssize_t	sent;
+
+	while (size > 0)
+	{
+		sent = send(fd, buf, size, MSG_NOSIGNAL);
+		if (sent <= 0)
+			return (false);
+		buf = (char *)buf + sent;
+		size -= sent;
+	}
+	return (true);
+}
+
+bool	net_read(int fd, void *buf, size_t size)
+{
+	ssize_t	got;
+
+	while (size > 0)
+	{
+		got = recv(fd, buf, size, 0);
+		if (got <= 0)
+			return (false);
+		buf = (char *)buf + got;
+		size -= got;
+	}
+	return (true);
+}
+
+bool	net_send(int fd, t_msg_type type, void *payload, uint32_t size)
+{
+	t_msg_header	header;
+
+	header.type = type;
+	header.size = size;
+	if (!net_write(fd, &header, sizeof(header)))
+		return (false);
+	return (size == 0 || !payload || net_write(fd, payload, size));
+}
+
+double	net_clock(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}
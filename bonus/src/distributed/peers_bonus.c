@@ -0,0 +1,127 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   peers_bonus.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:31:58 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 23:58:12 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+#include <sys/socket.h>
+#include <signal.h>
+
+static bool	send_job(t_coordinator *co, int fd)
+{
+	uint32_t	len;
+
+	len = ft_strlen(co->opts->scene);
+	return (net_send(fd, MSG_SCENE, NULL, sizeof(t_job) + len)
+		&& net_write(fd, &co->opts->job, sizeof(t_job))
+		&& net_write(fd, co->opts->scene, len));
+}
+
+/*
+** A new connection gets the job straight away; it only receives tiles
+** once it answers READY, which it must do within the tile timeout or
+** lose its slot. Reads are bounded by the same timeout so a worker that
+** stalls mid-message cannot wedge the coordinator.
+*/
+bool	accept_peer(t_coordinator *co)
+{
+	struct timeval	tv;
+	int				fd;
+
+	fd = accept(co->listen_fd, NULL, NULL);
+	if (fd < 0)
+		return (false);
+	net_nodelay(fd);
+	tv.tv_sec = (time_t)co->opts->tile_timeout;
+	tv.tv_usec = (co->opts->tile_timeout - tv.tv_sec) * 1e6;
+	if (co->peer_count == MAX_WORKERS
+		|| setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) < 0
+		|| !send_job(co, fd))
+		return (close(fd), false);
+	co->peers[co->peer_count++] = (t_peer){fd, 0, -1,
+		net_clock() + co->opts->tile_timeout, false};
+	return (true);
+}
+
+/*
+** Forgets a worker and puts its in-flight tile back in the queue. A local
+** child that timed out is killed rather than left tracing a lost tile.
+*/
+void	drop_peer(t_coordinator *co, int index, char *reason)
+{
+	t_peer	*peer;
+	int		i;
+
+	peer = &co->peers[index];
+	printf("⚠️  Worker %d: %s", peer->pid, reason);
+	if (peer->tile >= 0)
+	{
+		printf(", tile %d requeued", peer->tile);
+		co->tiles[peer->tile] = TILE_PENDING;
+		if (peer->tile < co->cursor)
+			co->cursor = peer->tile;
+		co->reassigned++;
+	}
+	printf("\n");
+	i = 0;
+	while (peer->pid > 0 && i < co->child_count)
+	{
+		if (co->children[i] == peer->pid)
+			kill(peer->pid, SIGKILL);
+		i++;
+	}
+	close(peer->fd);
+	co->peers[index] = co->peers[--co->peer_count];
+}
+
+static bool	receive_tile(t_coordinator *co, t_peer *peer, uint32_t size)
+{
+	static float	rgb[TILE_SIZE * TILE_SIZE * 3];
+	t_tile			tile;
+	t_tile			expected;
+
+	if (peer->tile < 0 || size < sizeof(tile)
+		|| !net_read(peer->fd, &tile, sizeof(tile)))
+		return (false);
+	expected = region_tile(co->region, peer->tile);
+	if (ft_memcmp(&tile, &expected, sizeof(tile)) != 0
+		|| size != sizeof(tile) + tile.w * tile.h * 3 * sizeof(float)
+		|| !net_read(peer->fd, rgb, size - sizeof(tile)))
+		return (false);
+	framebuffer_blit(co->fb, tile, rgb);
+	co->tiles[peer->tile] = TILE_DONE;
+	co->tiles_done++;
+	coordinator_checkpoint_tile(co, peer->tile);
+	peer->tile = -1;
+	return (true);
+}
+
+/*
+** Handles one message from a readable worker; anything unexpected (EOF,
+** a short read, a tile it was not given) drops the worker.
+*/
+bool	receive_from_peer(t_coordinator *co, int index)
+{
+	t_msg_header	header;
+	t_peer			*peer;
+
+	peer = &co->peers[index];
+	if (!net_read(peer->fd, &header, sizeof(header)))
+		return (drop_peer(co, index, "connection lost"), false);
+	if (header.type == MSG_READY && !peer->ready
+		&& header.size == sizeof(int)
+		&& net_read(peer->fd, &peer->pid, sizeof(int)))
+		return (peer->ready = true, true);
+	if (header.type == MSG_FAIL)
+		return (drop_peer(co, index, "could not load the scene"), false);
+	if (header.type == MSG_RESULT && receive_tile(co, peer, header.size))
+		return (true);
+	return (drop_peer(co, index, "protocol error"), false);
+}
@@ -0,0 +1,141 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   worker_bonus.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:24:45 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 20:28:55 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+/*
+** The job names the scene by path, so a remote worker must see the same
+** file tree (scene and textures) at the same relative location.
+*/
+static bool	load_job(int fd, uint32_t size, t_data *data)
+{
+	t_job		job;
+	char		*path;
+	t_camera	cam;
+	bool		ok;
+
+	if (size <= sizeof(job) || size > sizeof(job) + 4096
+		|| !net_read(fd, &job, sizeof(job)))
+		return (false);
+	path = ft_calloc(size - sizeof(job) + 1, 1);
+	if (!path || !net_read(fd, path, size - sizeof(job)))
+		return (free(path), false);
+	data->opts.job = job;
+	ok = complete_parsing(path, data);
+	free(path);
+	if (ok)
+		setup_world(data, &cam);
+	return (ok);
+}
+
+static void	trace_tile(t_data *data, t_tile tile, float *rgb)
+{
+	t_world	world;
+	int		x;
+	int		y;
+	t_tuple	color;
+
+	world = data->world;
+	world.primary = frustum_objects(&data->world, data->cam, tile);
+	y = 0;
+	while (y < tile.h)
+	{
+		x = 0;
+		while (x < tile.w)
+		{
+			color = trace_pixel(world, data->cam, tile.x + x,
+					tile.y + y, data->opts.job.samples);
+			rgb[(y * tile.w + x) * 3 + 0] = color.x;
+			rgb[(y * tile.w + x) * 3 + 1] = color.y;
+			rgb[(y * tile.w + x) * 3 + 2] = color.z;
+			x++;
+		}
+		y++;
+	}
+	free(world.primary);
+}
+
+static bool	serve_tile(int fd, t_data *data, float *rgb)
+{
+	t_tile		tile;
+	uint32_t	bytes;
+	uint64_t	start;
+
+	if (!net_read(fd, &tile, sizeof(tile)))
+		return (false);
+	if (tile.x < 0 || tile.y < 0 || tile.w <= 0 || tile.h <= 0
+		|| tile.w > TILE_SIZE || tile.h > TILE_SIZE
+		|| tile.x + tile.w > data->opts.job.width
+		|| tile.y + tile.h > data->opts.job.height)
+		return (false);
+	start = prof_now();
+	trace_tile(data, tile, rgb);
+	prof_span("tile", start, -1);
+	bytes = (uint32_t)tile.w * tile.h * 3 * sizeof(float);
+	return (net_send(fd, MSG_RESULT, NULL, sizeof(tile) + bytes)
+		&& net_write(fd, &tile, sizeof(tile))
+		&& net_write(fd, rgb, bytes));
+}
+
+static bool	serve(int fd, t_data *data, float *rgb)
+{
+	t_msg_header	header;
+	bool			loaded;
+
+	loaded = false;
+	while (net_read(fd, &header, sizeof(header)))
+	{
+		if (header.type == MSG_SCENE && !loaded)
+		{
+			loaded = load_job(fd, header.size, data);
+			if (!loaded)
+				return (net_send(fd, MSG_FAIL, NULL, 0), false);
+			if (!net_send(fd, MSG_READY, &(int){getpid()}, sizeof(int)))
+				return (false);
+		}
+		else if (header.type == MSG_TILE && loaded
+			&& header.size == sizeof(t_tile))
+		{
+			if (!serve_tile(fd, data, rgb))
+				return (false);
+		}
+		else
+			return (header.type == MSG_DONE);
+	}
+	return (false);
+}
+
+/*
+** Worker side of --workers/--listen: connect to the coordinator, load the
+** scene it names, then trace tiles single-threaded until told to stop.
+** One process per core is the unit of parallelism here.
+*/
+int	run_worker(t_options *opts)
+{
+	t_data	data;
+	float	*rgb;
+	int		fd;
+	bool	ok;
+
+	data = (t_data){};
+	data.opts = *opts;
+	prof_thread("worker");
+	fd = net_connect(opts->worker);
+	if (fd < 0)
+		return (1);
+	rgb = malloc(TILE_SIZE * TILE_SIZE * 3 * sizeof(float));
+	ok = rgb && serve(fd, &data, rgb);
+	free(rgb);
+	free_objects_and_lights(&data);
+	close(fd);
+	return (!ok);
+}
@@ -0,0 +1,200 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bounds_bonus.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 11:31:33 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 07:58:23 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+/*
+** World-space box of a local box under m (Arvo): each output axis takes the
+** translation plus, per input axis, whichever corner makes it smallest or
+** largest. Padded so float error in the slab test can never cull a hit.
+*/
+static t_bounds	transform_bounds(t_matrix m, t_tuple lo, t_tuple hi)
+{
+	t_bounds	b;
+	float		l[3];
+	float		h[3];
+	int			i;
+	int			j;
+
+	l[0] = lo.x;
+	l[1] = lo.y;
+	l[2] = lo.z;
+	h[0] = hi.x;
+	h[1] = hi.y;
+	h[2] = hi.z;
+	i = -1;
+	while (++i < 3)
+	{
+		(&b.min.x)[i] = m.mtrx[i][3];
+		(&b.max.x)[i] = m.mtrx[i][3];
+		j = -1;
+		while (++j < 3)
+		{
+			(&b.min.x)[i] += fminf(m.mtrx[i][j] * l[j], m.mtrx[i][j] * h[j]);
+			(&b.max.x)[i] += fmaxf(m.mtrx[i][j] * l[j], m.mtrx[i][j] * h[j]);
+		}
+	}
+	b.finite = true;
+	return (b);
+}
+
+static void	add_disk(t_bounds *b, t_tuple center, t_tuple axis, float radius)
+{
+	float	r[3];
+	int		i;
+
+	r[0] = radius * sqrtf(fmaxf(0.0f, 1.0f - axis.x * axis.x));
+	r[1] = radius * sqrtf(fmaxf(0.0f, 1.0f - axis.y * axis.y));
+	r[2] = radius * sqrtf(fmaxf(0.0f, 1.0f - axis.z * axis.z));
+	i = -1;
+	while (++i < 3)
+	{
+		(&b->min.x)[i] = fminf((&b->min.x)[i], (&center.x)[i] - r[i]);
+		(&b->max.x)[i] = fmaxf((&b->max.x)[i], (&center.x)[i] + r[i]);
+	}
+}
+
+/*
+** The cone is intersected in world space between the two cap disks at
+** minimum and maximum along its axis; their hull also holds the apex.
+*/
+static t_bounds	cone_bounds(t_cone *co)
+{
+	t_bounds	b;
+	float		k;
+
+	b.min = (t_tuple){INFINITY, INFINITY, INFINITY, 1};
+	b.max = (t_tuple){-INFINITY, -INFINITY, -INFINITY, 1};
+	k = fabsf(tanf(co->angle));
+	add_disk(&b, add_tuple(co->center, tuple_scalar_mult(co->axis,
+				co->minimum)), co->axis, fabsf(co->minimum) * k);
+	add_disk(&b, add_tuple(co->center, tuple_scalar_mult(co->axis,
+				co->maximum)), co->axis, fabsf(co->maximum) * k);
+	b.finite = true;
+	return (b);
+}
+
+/*
+** The root node box of the mesh BVH, taken to world space.
+*/
+static t_bounds	mesh_bounds(t_mesh *me)
+{
+	t_bvh_node	*root;
+
+	root = &me->geo->nodes[0];
+	return (transform_bounds(me->trans,
+			(t_tuple){root->min[0], root->min[1], root->min[2], 1},
+			(t_tuple){root->max[0], root->max[1], root->max[2], 1}));
+}
+
+static void	pad_bounds(t_bounds *b)
+{
+	float	pad;
+	int		i;
+
+	i = -1;
+	while (++i < 3)
+	{
+		pad = 1e-3f * (1.0f + (&b->max.x)[i] - (&b->min.x)[i]
+				+ fabsf((&b->min.x)[i]) + fabsf((&b->max.x)[i]));
+		(&b->min.x)[i] -= pad;
+		(&b->max.x)[i] += pad;
+	}
+	b->finite = isfinite(b->min.x) && isfinite(b->min.y)
+		&& isfinite(b->min.z) && isfinite(b->max.x)
+		&& isfinite(b->max.y) && isfinite(b->max.z);
+}
+
+/*
+** A local box b seen through m, padded again for the extra rounding.
+*/
+t_bounds	transformed_bounds(t_matrix m, t_bounds b)
+{
+	b = transform_bounds(m, b.min, b.max);
+	pad_bounds(&b);
+	return (b);
+}
+
+t_bounds	object_bounds(t_object *obj)
+{
+	t_bounds	b;
+	t_tuple		c;
+
+	b = (t_bounds){{0, 0, 0, 1}, {0, 0, 0, 1}, false};
+	if (obj->type == OBJ_SPHERE)
+	{
+		c = obj->shape.sp.center;
+		b = transform_bounds(obj->shape.sp.trans,
+				(t_tuple){c.x - 1, c.y - 1, c.z - 1, 1},
+				(t_tuple){c.x + 1, c.y + 1, c.z + 1, 1});
+	}
+	else if (obj->type == OBJ_CYLINDER)
+		b = transform_bounds(obj->shape.cy.trans,
+				(t_tuple){-1, obj->shape.cy.minimum, -1, 1},
+				(t_tuple){1, obj->shape.cy.maximum, 1, 1});
+	else if (obj->type == OBJ_CONE)
+		b = cone_bounds(&obj->shape.co);
+	else if (obj->type == OBJ_MESH)
+		b = mesh_bounds(&obj->shape.me);
+	if (b.finite)
+		pad_bounds(&b);
+	return (b);
+}
+
+static bool	clip_slab(float origin, float dir, float slab[2], float range[2])
+{
+	float	t0;
+	float	t1;
+	float	tmp;
+
+	if (fabsf(dir) < 1e-12f)
+		return (origin >= slab[0] && origin <= slab[1]);
+	t0 = (slab[0] - origin) / dir;
+	t1 = (slab[1] - origin) / dir;
+	if (t0 > t1)
+	{
+		tmp = t0;
+		t0 = t1;
+		t1 = tmp;
+	}
+	if (t0 > range[0])
+		range[0] = t0;
+	if (t1 < range[1])
+		range[1] = t1;
+	return (range[0] <= range[1]);
+}
+
+/*
+** Slab test over t in [0, t_max]. Unbounded objects (planes, infinite
+** cylinders) always pass.
+*/
+bool	ray_hits_bounds(t_bounds *b, t_ray ray, float t_max)
+{
+	float	range[2];
+	float	slab[2];
+
+	if (!b->finite)
+		return (true);
+	range[0] = 0.0f;
+	range[1] = t_max;
+	slab[0] = b->min.x;
+	slab[1] = b->max.x;
+	if (!clip_slab(ray.origin.x, ray.direction.x, slab, range))
+		return (false);
+	slab[0] = b->min.y;
+	slab[1] = b->max.y;
+	if (!clip_slab(ray.origin.y, ray.direction.y, slab, range))
+		return (false);
+	slab[0] = b->min.z;
+	slab[1] = b->max.z;
+	return (clip_slab(ray.origin.z, ray.direction.z, slab, range));
+}
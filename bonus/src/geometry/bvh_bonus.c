@@ -0,0 +1,258 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bvh_bonus.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 06:10:08 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 06:10:08 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+typedef struct s_bvh_bin
+{
+	float	box[6];
+	int		count;
+}	t_bvh_bin;
+
+/*
+** A split candidate: its axis, the last bin going left, and the SAH cost
+** (surface area times item count, summed over both sides).
+*/
+typedef struct s_bvh_split
+{
+	int		axis;
+	int		bin;
+	float	cost;
+	float	lo;
+	float	scale;
+}	t_bvh_split;
+
+/*
+** Build state. A binary tree over n leaves never needs more than 2n - 1
+** nodes, so the node pool is allocated once.
+*/
+typedef struct s_bvh_build
+{
+	t_bvh_node	*nodes;
+	t_bvh_ref	*refs;
+	int			used;
+}	t_bvh_build;
+
+static void	grow_box(float dst[6], const float src[6])
+{
+	int	i;
+
+	i = -1;
+	while (++i < 3)
+	{
+		dst[i] = bvh_min(dst[i], src[i]);
+		dst[i + 3] = bvh_max(dst[i + 3], src[i + 3]);
+	}
+}
+
+static void	empty_box(float box[6])
+{
+	box[0] = INFINITY;
+	box[1] = INFINITY;
+	box[2] = INFINITY;
+	box[3] = -INFINITY;
+	box[4] = -INFINITY;
+	box[5] = -INFINITY;
+}
+
+static float	half_area(const float box[6])
+{
+	float	d[3];
+
+	if (box[0] > box[3])
+		return (0.0f);
+	d[0] = box[3] - box[0];
+	d[1] = box[4] - box[1];
+	d[2] = box[5] - box[2];
+	return (d[0] * d[1] + d[1] * d[2] + d[2] * d[0]);
+}
+
+/*
+** Fills the node's box and returns the bounds of its centroids in cb.
+*/
+static void	node_bounds(t_bvh_build *b, t_bvh_node *node, float cb[6])
+{
+	float	box[6];
+	int		i;
+	int		j;
+
+	empty_box(box);
+	empty_box(cb);
+	i = node->start - 1;
+	while (++i < node->start + node->count)
+	{
+		grow_box(box, b->refs[i].box);
+		j = -1;
+		while (++j < 3)
+		{
+			cb[j] = bvh_min(cb[j], b->refs[i].cen[j]);
+			cb[j + 3] = bvh_max(cb[j + 3], b->refs[i].cen[j]);
+		}
+	}
+	ft_memcpy(node->min, box, 3 * sizeof(float));
+	ft_memcpy(node->max, box + 3, 3 * sizeof(float));
+}
+
+static int	bin_of(const t_bvh_ref *r, const t_bvh_split *s)
+{
+	int	bin;
+
+	bin = (int)((r->cen[s->axis] - s->lo) * s->scale);
+	if (bin < 0)
+		return (0);
+	if (bin >= BVH_BINS)
+		return (BVH_BINS - 1);
+	return (bin);
+}
+
+/*
+** Bins the node's centroids along one axis and sweeps the bins from both
+** ends for the cheapest split, keeping it in best if it beats it.
+*/
+static void	try_axis(t_bvh_build *b, t_bvh_node *node, t_bvh_split s,
+	t_bvh_split *best)
+{
+	t_bvh_bin	bins[BVH_BINS];
+	float		right_cost[BVH_BINS];
+	t_bvh_bin	acc;
+	int			i;
+
+	i = -1;
+	while (++i < BVH_BINS)
+	{
+		empty_box(bins[i].box);
+		bins[i].count = 0;
+	}
+	i = node->start - 1;
+	while (++i < node->start + node->count)
+	{
+		s.bin = bin_of(&b->refs[i], &s);
+		bins[s.bin].count++;
+		grow_box(bins[s.bin].box, b->refs[i].box);
+	}
+	acc = bins[BVH_BINS - 1];
+	i = BVH_BINS - 1;
+	while (--i >= 0)
+	{
+		right_cost[i] = half_area(acc.box) * acc.count;
+		grow_box(acc.box, bins[i].box);
+		acc.count += bins[i].count;
+	}
+	acc = bins[0];
+	s.bin = -1;
+	while (++s.bin < BVH_BINS - 1)
+	{
+		s.cost = half_area(acc.box) * acc.count + right_cost[s.bin];
+		if (acc.count > 0 && acc.count < node->count && s.cost < best->cost)
+			*best = s;
+		grow_box(acc.box, bins[s.bin + 1].box);
+		acc.count += bins[s.bin + 1].count;
+	}
+}
+
+static int	partition(t_bvh_build *b, t_bvh_node *node, t_bvh_split *s)
+{
+	t_bvh_ref	tmp;
+	int			left;
+	int			i;
+
+	left = node->start;
+	i = node->start - 1;
+	while (++i < node->start + node->count)
+	{
+		if (bin_of(&b->refs[i], s) > s->bin)
+			continue ;
+		tmp = b->refs[i];
+		b->refs[i] = b->refs[left];
+		b->refs[left++] = tmp;
+	}
+	return (left - node->start);
+}
+
+/*
+** Number of items going left, 0 to keep the node a leaf. SAH with a unit
+** intersection cost and BVH_TRAVERSAL_COST per node visited; when binning
+** cannot separate the items (shared centroids) an oversized node is cut
+** in half as it is.
+*/
+static int	split_node(t_bvh_build *b, t_bvh_node *node, float cb[6])
+{
+	t_bvh_split	best;
+	t_bvh_split	s;
+	float		box[6];
+
+	best = (t_bvh_split){-1, 0, INFINITY, 0, 0};
+	s.axis = -1;
+	while (++s.axis < 3)
+	{
+		s.lo = cb[s.axis];
+		if (cb[s.axis + 3] - s.lo > 0.0f)
+		{
+			s.scale = BVH_BINS / (cb[s.axis + 3] - s.lo);
+			try_axis(b, node, s, &best);
+		}
+	}
+	ft_memcpy(box, node->min, 3 * sizeof(float));
+	ft_memcpy(box + 3, node->max, 3 * sizeof(float));
+	if (best.axis >= 0 && (node->count > BVH_MAX_LEAF || BVH_TRAVERSAL_COST
+			+ best.cost / half_area(box) < node->count))
+		return (partition(b, node, &best));
+	if (node->count > BVH_MAX_LEAF)
+		return (node->count / 2);
+	return (0);
+}
+
+static void	build_node(t_bvh_build *b, int index, int depth)
+{
+	t_bvh_node	*node;
+	t_bvh_node	*child;
+	float		cb[6];
+	int			left;
+
+	node = &b->nodes[index];
+	node_bounds(b, node, cb);
+	left = 0;
+	if (node->count > 1 && depth < BVH_MAX_DEPTH)
+		left = split_node(b, node, cb);
+	if (left == 0)
+		return ;
+	child = &b->nodes[b->used];
+	child[0] = (t_bvh_node){{0}, {0}, node->start, left};
+	child[1] = (t_bvh_node){{0}, {0}, node->start + left, node->count - left};
+	node->start = b->used;
+	node->count = 0;
+	b->used += 2;
+	build_node(b, node->start, depth + 1);
+	build_node(b, node->start + 1, depth + 1);
+}
+
+/*
+** Binned SAH build, top down, over count items (count > 0). Leaves the
+** refs in leaf order, so refs[i].index is the item a leaf's i-th slot
+** holds. Returns the node count, 0 when out of memory.
+*/
+int	bvh_build(t_bvh_ref *refs, int count, t_bvh_node **nodes)
+{
+	t_bvh_build	b;
+	t_bvh_node	*shrunk;
+
+	*nodes = malloc(sizeof(t_bvh_node) * (2 * (size_t)count));
+	if (!*nodes)
+		return (0);
+	b = (t_bvh_build){*nodes, refs, 1};
+	b.nodes[0] = (t_bvh_node){{0}, {0}, 0, count};
+	build_node(&b, 0, 0);
+	shrunk = realloc(b.nodes, sizeof(t_bvh_node) * b.used);
+	if (shrunk)
+		*nodes = shrunk;
+	return (b.used);
+}
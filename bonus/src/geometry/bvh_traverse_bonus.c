@@ -0,0 +1,150 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bvh_traverse_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 06:17:21 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 10:29:56 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+#include <float.h>
+
+/*
+** A zero direction component gets a huge finite reciprocal instead of an
+** infinite one: a box face through the origin then gives 0, not the NaN
+** of 0 * inf, and the slab test keeps the node.
+*/
+t_bvh_ray	bvh_ray(t_ray ray, float t_min, float t_max)
+{
+	t_bvh_ray	r;
+	int			i;
+
+	r.org[0] = ray.origin.x;
+	r.org[1] = ray.origin.y;
+	r.org[2] = ray.origin.z;
+	r.dir[0] = ray.direction.x;
+	r.dir[1] = ray.direction.y;
+	r.dir[2] = ray.direction.z;
+	r.k[2] = 0;
+	i = -1;
+	while (++i < 3)
+	{
+		r.inv[i] = 1.0f / r.dir[i];
+		if (isinf(r.inv[i]))
+			r.inv[i] = copysignf(FLT_MAX, r.inv[i]);
+		if (fabsf(r.dir[i]) > fabsf(r.dir[r.k[2]]))
+			r.k[2] = i;
+	}
+	r.k[0] = (r.k[2] + 1) % 3;
+	r.k[1] = (r.k[0] + 1) % 3;
+	if (r.dir[r.k[2]] < 0.0f)
+	{
+		i = r.k[0];
+		r.k[0] = r.k[1];
+		r.k[1] = i;
+	}
+	r.shear[0] = r.dir[r.k[0]] / r.dir[r.k[2]];
+	r.shear[1] = r.dir[r.k[1]] / r.dir[r.k[2]];
+	r.shear[2] = 1.0f / r.dir[r.k[2]];
+	r.t_min = t_min;
+	r.t_max = t_max;
+	return (r);
+}
+
+/*
+** Slab test against a node box; *t_near is where the ray enters it. The
+** exit distance is padded a little so rounding never culls an item lying
+** on the box face.
+*/
+bool	bvh_hit_node(const t_bvh_node *n, const t_bvh_ray *r, float *t_near)
+{
+	float	t0;
+	float	t1;
+	float	t_far;
+	int		i;
+
+	*t_near = r->t_min;
+	t_far = r->t_max;
+	i = -1;
+	while (++i < 3)
+	{
+		t0 = (n->min[i] - r->org[i]) * r->inv[i];
+		t1 = (n->max[i] - r->org[i]) * r->inv[i];
+		*t_near = bvh_max(*t_near, bvh_min(t0, t1));
+		t_far = bvh_min(t_far, bvh_max(t0, t1));
+	}
+	return (*t_near <= t_far + fabsf(t_far) * BVH_SLAB_PAD);
+}
+
+/*
+** Visits every leaf whose box the ray enters, in no particular order,
+** until visit returns true (which this then returns).
+*/
+bool	bvh_walk(const t_bvh_node *nodes, const t_bvh_ray *r, t_bvh_leaf visit,
+	void *ctx)
+{
+	t_bvh_stack	st;
+	float		t;
+	int			node;
+
+	st.size = 0;
+	node = 0;
+	while (1)
+	{
+		if (bvh_hit_node(&nodes[node], r, &t))
+		{
+			if (nodes[node].count > 0 && visit(ctx, &nodes[node]))
+				return (true);
+			if (nodes[node].count == 0)
+			{
+				st.node[st.size++] = nodes[node].start + 1;
+				node = nodes[node].start;
+				continue ;
+			}
+		}
+		if (st.size == 0)
+			return (false);
+		node = st.node[--st.size];
+	}
+}
+
+static bool	node_contains(const t_bvh_node *n, const float p[3])
+{
+	return (p[0] >= n->min[0] && p[0] <= n->max[0]
+		&& p[1] >= n->min[1] && p[1] <= n->max[1]
+		&& p[2] >= n->min[2] && p[2] <= n->max[2]);
+}
+
+/*
+** Same walk for a point: visits every leaf whose box contains p.
+*/
+bool	bvh_query(const t_bvh_node *nodes, const float p[3], t_bvh_leaf visit,
+	void *ctx)
+{
+	t_bvh_stack	st;
+	int			node;
+
+	st.size = 0;
+	node = 0;
+	while (1)
+	{
+		if (node_contains(&nodes[node], p))
+		{
+			if (nodes[node].count > 0 && visit(ctx, &nodes[node]))
+				return (true);
+			if (nodes[node].count == 0)
+			{
+				st.node[st.size++] = nodes[node].start + 1;
+				node = nodes[node].start;
+				continue ;
+			}
+		}
+		if (st.size == 0)
+			return (false);
+		node = st.node[--st.size];
+	}
+}
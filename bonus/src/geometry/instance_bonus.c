@@ -0,0 +1,152 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   instance_bonus.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 06:24:34 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 06:24:34 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+/*
+** One walk of the two levels. ray is the world ray while the top level is
+** walked and the instance's prototype-space copy below it; any asks for
+** the first member blocking a shadow ray, otherwise every hit goes to xs.
+*/
+typedef struct s_inst_query
+{
+	t_instances	*set;
+	t_instance	*inst;
+	t_ray		ray;
+	t_ray		world;
+	float		t_max;
+	bool		any;
+	t_inters	**xs;
+	t_ray_stats	*stats;
+}	t_inst_query;
+
+/*
+** Hits of one member, tagged with the instance and put in front of xs
+** (intersect_world sorts the list afterwards).
+*/
+static void	add_member_hits(t_inst_query *q, t_object *member)
+{
+	t_inters	*local;
+	t_inters	*last;
+
+	local = NULL;
+	intersect_object(member, q->ray, &local);
+	if (!local)
+		return ;
+	last = local;
+	while (1)
+	{
+		last->inst = q->inst;
+		if (!last->next)
+			break ;
+		last = last->next;
+	}
+	last->next = *q->xs;
+	*q->xs = local;
+}
+
+static bool	visit_members(void *ctx, const t_bvh_node *leaf)
+{
+	t_inst_query	*q;
+	t_object		*member;
+	int				i;
+
+	q = ctx;
+	i = leaf->start - 1;
+	while (++i < leaf->start + leaf->count)
+	{
+		member = q->inst->proto->order[i];
+		if (q->any)
+		{
+			if (object_material(member)->casts_shadow
+				&& blocks_shadow_ray(member, q->ray, q->t_max, q->stats))
+				return (true);
+		}
+		else if (ray_hits_bounds(&member->bounds, q->ray, q->t_max))
+		{
+			if (q->stats)
+				q->stats->tests++;
+			add_member_hits(q, member);
+		}
+	}
+	return (false);
+}
+
+/*
+** The ray is taken into each instance's prototype space (the affine map
+** keeps t, so hits and distances need no conversion) and walked down the
+** prototype's own BVH.
+*/
+static bool	visit_instances(void *ctx, const t_bvh_node *leaf)
+{
+	t_inst_query	*q;
+	t_bvh_ray		r;
+	int				i;
+
+	q = ctx;
+	i = leaf->start - 1;
+	while (++i < leaf->start + leaf->count)
+	{
+		q->inst = &q->set->items[i];
+		q->ray = transform_ray(q->world, q->inst->trans_inv);
+		r = bvh_ray(q->ray, 0.0f, q->t_max);
+		if (bvh_walk(q->inst->proto->nodes, &r, visit_members, q))
+			return (true);
+	}
+	return (false);
+}
+
+/*
+** Adds every hit on an instanced member to xs. Like the scene objects,
+** instances are culled on hits in front of the origin only.
+*/
+void	intersect_instances(t_instances *set, t_ray ray, t_inters **xs,
+	t_ray_stats *stats)
+{
+	t_inst_query	q;
+	t_bvh_ray		r;
+
+	if (!set || set->count == 0)
+		return ;
+	q = (t_inst_query){set, NULL, ray, ray, INFINITY, false, xs, stats};
+	r = bvh_ray(ray, 0.0f, INFINITY);
+	bvh_walk(set->nodes, &r, visit_instances, &q);
+}
+
+/*
+** Any-hit query for a shadow ray: true at the first shadow-casting member
+** between the surface and the light.
+*/
+bool	instances_occlude(t_instances *set, t_ray ray, float max_distance,
+	t_ray_stats *stats)
+{
+	t_inst_query	q;
+	t_bvh_ray		r;
+
+	if (!set || set->count == 0)
+		return (false);
+	q = (t_inst_query){set, NULL, ray, ray, max_distance, true, NULL, stats};
+	r = bvh_ray(ray, 0.0f, max_distance);
+	return (bvh_walk(set->nodes, &r, visit_instances, &q));
+}
+
+/*
+** A normal from prototype space to the world, by the inverse transpose of
+** the instance transform.
+*/
+t_tuple	instance_normal(t_instance *inst, t_tuple normal)
+{
+	normal = multiply_matrix_by_tuple(transposing_matrix(inst->trans_inv),
+			normal);
+	normal.w = 0;
+	return (normalizing_vector(normal));
+}
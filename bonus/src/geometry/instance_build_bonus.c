@@ -0,0 +1,179 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   instance_build_bonus.c                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 06:31:47 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 06:31:47 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+static void	bounds_to_ref(t_bounds b, int index, t_bvh_ref *r)
+{
+	int	k;
+
+	r->index = index;
+	k = -1;
+	while (++k < 3)
+	{
+		r->box[k] = (&b.min.x)[k];
+		r->box[k + 3] = (&b.max.x)[k];
+		r->cen[k] = 0.5f * (r->box[k] + r->box[k + 3]);
+	}
+}
+
+/*
+** Builds the BVH over the prototype's members (their bounds are already in
+** prototype space) and lists them in leaf order. Done once, when the
+** prototype is first instanced.
+*/
+static bool	proto_seal(t_proto *proto)
+{
+	t_bvh_ref	*refs;
+	t_object	**list;
+	t_object	*obj;
+	int			i;
+
+	if (proto->nodes)
+		return (true);
+	proto->count = 0;
+	obj = proto->members;
+	while (obj && ++proto->count)
+		obj = obj->next;
+	refs = malloc(sizeof(t_bvh_ref) * proto->count);
+	list = malloc(sizeof(t_object *) * proto->count);
+	proto->order = malloc(sizeof(t_object *) * proto->count);
+	i = 0;
+	obj = proto->members;
+	while (refs && list && obj)
+	{
+		list[i] = obj;
+		bounds_to_ref(obj->bounds, i, &refs[i]);
+		obj = obj->next;
+		i++;
+	}
+	if (refs && list && proto->order)
+		proto->node_count = bvh_build(refs, proto->count, &proto->nodes);
+	i = -1;
+	while (proto->node_count > 0 && ++i < proto->count)
+		proto->order[i] = list[refs[i].index];
+	free(refs);
+	free(list);
+	return (proto->node_count > 0);
+}
+
+static bool	grow_instances(t_instances *set)
+{
+	t_instance	*items;
+	t_bvh_ref	*refs;
+	int			capacity;
+
+	capacity = set->capacity * 2;
+	if (capacity < 64)
+		capacity = 64;
+	items = realloc(set->items, sizeof(t_instance) * capacity);
+	if (items)
+		set->items = items;
+	refs = realloc(set->refs, sizeof(t_bvh_ref) * capacity);
+	if (refs)
+		set->refs = refs;
+	if (!items || !refs)
+		return (false);
+	set->capacity = capacity;
+	return (true);
+}
+
+/*
+** Places proto in the world through trans (inv is its inverse). The
+** prototype's box goes to the world so the top level can be built once
+** parsing ends.
+*/
+bool	instance_add(t_instances *set, t_proto *proto, t_matrix trans,
+	t_matrix inv)
+{
+	t_bvh_node	*root;
+	t_bounds	local;
+
+	if (!proto_seal(proto) || (set->count == set->capacity
+			&& !grow_instances(set)))
+		return (false);
+	root = &proto->nodes[0];
+	local = (t_bounds){{root->min[0], root->min[1], root->min[2], 1},
+	{root->max[0], root->max[1], root->max[2], 1}, true};
+	bounds_to_ref(transformed_bounds(trans, local), set->count,
+		&set->refs[set->count]);
+	set->items[set->count].proto = proto;
+	set->items[set->count].trans_inv = inv;
+	set->count++;
+	return (true);
+}
+
+/*
+** Moves the instances into leaf order, as mesh triangles are.
+*/
+static bool	reorder_instances(t_instances *set)
+{
+	t_instance	*sorted;
+	int			i;
+
+	sorted = malloc(sizeof(t_instance) * set->count);
+	if (!sorted)
+		return (false);
+	i = -1;
+	while (++i < set->count)
+		sorted[i] = set->items[set->refs[i].index];
+	free(set->items);
+	set->items = sorted;
+	set->capacity = set->count;
+	return (true);
+}
+
+static bool	instances_transparent(t_instances *set)
+{
+	t_proto		*proto;
+	t_object	*obj;
+
+	proto = set->protos;
+	while (proto)
+	{
+		obj = proto->members;
+		while (proto->nodes && obj)
+		{
+			if (object_material(obj)->transparency > 0.0)
+				return (true);
+			obj = obj->next;
+		}
+		proto = proto->next;
+	}
+	return (false);
+}
+
+/*
+** Top level over the world boxes the inst lines collected. Run once the
+** whole file is parsed; the boxes are not needed afterwards.
+*/
+bool	instances_build(t_instances *set)
+{
+	uint64_t	start;
+	bool		ok;
+
+	if (set->count == 0)
+		return (true);
+	start = prof_now();
+	set->node_count = bvh_build(set->refs, set->count, &set->nodes);
+	ok = set->node_count > 0 && reorder_instances(set);
+	free(set->refs);
+	set->refs = NULL;
+	set->transparent = instances_transparent(set);
+	prof_span("build_instances", start, set->count);
+	if (!ok)
+		return (printf("❌ inst: Out of memory building the instance BVH\n"),
+			false);
+	printf("✅ Instances: %d, %d top-level BVH nodes\n", set->count,
+		set->node_count);
+	return (true);
+}
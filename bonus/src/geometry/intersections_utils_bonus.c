@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2025/12/02 22:48:42 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 08:05:36 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -21,6 +21,10 @@ t_inters	*new_intersection(float t, t_object *obj)
 		return (NULL);
 	new->object = obj;
 	new->t = t;
+	new->prim = -1;
+	new->u = 0.0f;
+	new->v = 0.0f;
+	new->inst = NULL;
 	new->next = NULL;
 	return (new);
 }
@@ -42,12 +46,24 @@ void	ft_add_intersection(t_inters **lst, t_inters *new)
 	ptr->next = new;
 }
 
+/*
+** Swaps the payload of two nodes and keeps the links in place.
+*/
+static void	swap_intersections(t_inters *a, t_inters *b)
+{
+	t_inters	tmp;
+
+	tmp = *a;
+	*a = *b;
+	a->next = tmp.next;
+	tmp.next = b->next;
+	*b = tmp;
+}
+
 void	sort_intersections(t_inters **lst)
 {
 	t_inters	*i1;
 	t_inters	*i2;
-	float		temp_t;
-	t_object	*temp_obj;
 
 	if (!lst || !*lst)
 		return ;
@@ -58,14 +74,7 @@ void	sort_intersections(t_inters **lst)
 		while (i2)
 		{
 			if (i1->t > i2->t)
-			{
-				temp_t = i1->t;
-				temp_obj = i1->object;
-				i1->t = i2->t;
-				i1->object = i2->object;
-				i2->t = temp_t;
-				i2->object = temp_obj;
-			}
+				swap_intersections(i1, i2);
 			i2 = i2->next;
 		}
 		i1 = i1->next;
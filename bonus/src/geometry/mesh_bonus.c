@@ -0,0 +1,100 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mesh_bonus.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 04:14:40 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 04:14:40 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+static t_tuple	vertex(const float *array, int index)
+{
+	return ((t_tuple){array[3 * index], array[3 * index + 1],
+		array[3 * index + 2], 0});
+}
+
+/*
+** Blend of the three corner vectors of a triangle by the hit barycentrics.
+*/
+static t_tuple	interpolate(const float *array, const int corner[3],
+	t_inters *hit)
+{
+	t_tuple	n;
+
+	n = tuple_scalar_mult(vertex(array, corner[0]), 1.0f - hit->u - hit->v);
+	n = add_tuple(n, tuple_scalar_mult(vertex(array, corner[1]), hit->u));
+	return (add_tuple(n, tuple_scalar_mult(vertex(array, corner[2]),
+				hit->v)));
+}
+
+/*
+** Smooth normal from the OBJ vertex normals when the face has them, the
+** flat face normal otherwise (or when the blend cancels out).
+*/
+t_tuple	mesh_normal_at(t_mesh *me, t_inters *hit)
+{
+	t_mesh_tri	*tri;
+	t_tuple		n;
+	t_tuple		p0;
+
+	tri = &me->geo->tris[hit->prim];
+	n = (t_tuple){0, 0, 0, 0};
+	if (tri->n[0] >= 0)
+		n = interpolate(me->geo->nrm, tri->n, hit);
+	if (vecs_dot_product(n, n) == 0.0f)
+	{
+		p0 = vertex(me->geo->pos, tri->v[0]);
+		n = vecs_cross_product(
+				substract_tuple(vertex(me->geo->pos, tri->v[1]), p0),
+				substract_tuple(vertex(me->geo->pos, tri->v[2]), p0));
+	}
+	n = multiply_matrix_by_tuple(transposing_matrix(me->trans_inv), n);
+	n.w = 0;
+	return (normalizing_vector(n));
+}
+
+/*
+** Texture coordinates of the hit, wrapped into [0, 1) so OBJ UVs that
+** tile keep tiling. Faces without UVs sample the texture's corner.
+*/
+t_tuple	mesh_uv_at(t_mesh *me, t_inters *hit)
+{
+	t_mesh_tri	*tri;
+	float		uv[2];
+	float		w[3];
+	int			i;
+
+	tri = &me->geo->tris[hit->prim];
+	if (tri->t[0] < 0)
+		return ((t_tuple){0, 0, 0, 0});
+	w[0] = 1.0f - hit->u - hit->v;
+	w[1] = hit->u;
+	w[2] = hit->v;
+	uv[0] = 0.0f;
+	uv[1] = 0.0f;
+	i = -1;
+	while (++i < 3)
+	{
+		uv[0] += w[i] * me->geo->uv[2 * tri->t[i]];
+		uv[1] += w[i] * me->geo->uv[2 * tri->t[i] + 1];
+	}
+	return ((t_tuple){uv[0] - floorf(uv[0]), uv[1] - floorf(uv[1]), 0, 0});
+}
+
+void	mesh_free(t_mesh_data *geo)
+{
+	if (!geo)
+		return ;
+	free(geo->path);
+	free(geo->pos);
+	free(geo->nrm);
+	free(geo->uv);
+	free(geo->tris);
+	free(geo->nodes);
+	free(geo);
+}
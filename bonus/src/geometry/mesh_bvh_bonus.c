@@ -0,0 +1,91 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mesh_bvh_bonus.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 04:00:14 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 08:12:49 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+
+#include "../../includes/miniRT_bonus.h"
+
+/*
+** Each triangle's box and centroid, taken from its three corners.
+*/
+static t_bvh_ref	*make_refs(t_mesh_data *m)
+{
+	t_bvh_ref	*refs;
+	t_bvh_ref	*r;
+	const float	*p;
+	int			i;
+	int			j;
+	int			k;
+
+	refs = malloc(sizeof(t_bvh_ref) * m->tri_count);
+	i = -1;
+	while (refs && ++i < m->tri_count)
+	{
+		r = &refs[i];
+		r->index = i;
+		j = -1;
+		while (++j < 3)
+		{
+			p = &m->pos[m->tris[i].v[j] * 3];
+			k = -1;
+			while (++k < 3)
+			{
+				if (j == 0 || p[k] < r->box[k])
+					r->box[k] = p[k];
+				if (j == 0 || p[k] > r->box[k + 3])
+					r->box[k + 3] = p[k];
+			}
+		}
+		k = -1;
+		while (++k < 3)
+			r->cen[k] = 0.5f * (r->box[k] + r->box[k + 3]);
+	}
+	return (refs);
+}
+
+/*
+** Moves the triangles into leaf order so every leaf is a contiguous run.
+*/
+static bool	reorder_triangles(t_mesh_data *m, t_bvh_ref *refs)
+{
+	t_mesh_tri	*sorted;
+	int			i;
+
+	sorted = malloc(sizeof(t_mesh_tri) * m->tri_count);
+	if (!sorted)
+		return (false);
+	i = -1;
+	while (++i < m->tri_count)
+		sorted[i] = m->tris[refs[i].index];
+	free(m->tris);
+	m->tris = sorted;
+	return (true);
+}
+
+/*
+** BVH over the mesh triangles, in object space.
+*/
+bool	mesh_build_bvh(t_mesh_data *m)
+{
+	t_bvh_ref	*refs;
+	bool		ok;
+	uint64_t	start;
+
+	start = prof_now();
+	refs = make_refs(m);
+	ok = refs != NULL;
+	if (ok)
+		m->node_count = bvh_build(refs, m->tri_count, &m->nodes);
+	ok = ok && m->node_count > 0 && reorder_triangles(m, refs);
+	free(refs);
+	prof_span("build_bvh", start, m->tri_count);
+	return (ok);
+}
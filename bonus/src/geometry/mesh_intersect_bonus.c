@@ -0,0 +1,232 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mesh_intersect_bonus.c                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 04:07:27 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 08:20:02 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+typedef enum e_mesh_mode
+{
+	MESH_NEAREST,
+	MESH_ALL,
+	MESH_ANY
+}	t_mesh_mode;
+
+/*
+** One traversal: the nearest hit so far (MESH_NEAREST shrinks ray.t_max to
+** it), every hit appended to xs (MESH_ALL), or any hit at all (MESH_ANY).
+*/
+typedef struct s_mesh_query
+{
+	t_bvh_ray	ray;
+	t_mesh_mode	mode;
+	t_mesh_hit	hit;
+	bool		found;
+	t_inters	**xs;
+	t_object	*obj;
+}	t_mesh_query;
+
+/*
+** Vertex p relative to the ray origin, in the sheared frame where the ray
+** runs along +z from (0, 0).
+*/
+static void	shear_vertex(const t_bvh_ray *r, const float *p, float out[3])
+{
+	float	rel[3];
+
+	rel[0] = p[0] - r->org[0];
+	rel[1] = p[1] - r->org[1];
+	rel[2] = p[2] - r->org[2];
+	out[0] = rel[r->k[0]] - r->shear[0] * rel[r->k[2]];
+	out[1] = rel[r->k[1]] - r->shear[1] * rel[r->k[2]];
+	out[2] = r->shear[2] * rel[r->k[2]];
+}
+
+/*
+** Watertight ray/triangle test (Woop, Benthin and Wald 2013). e holds the
+** 2D edge functions of the sheared triangle; an edge passing exactly
+** through the ray is redone in double so neighbouring triangles agree on
+** who owns it and no ray slips between them.
+*/
+static bool	hit_triangle(const t_mesh_data *m, const t_bvh_ray *r, int prim,
+	t_mesh_hit *h)
+{
+	float	v[3][3];
+	float	e[3];
+	float	det;
+	float	t;
+
+	shear_vertex(r, &m->pos[3 * m->tris[prim].v[0]], v[0]);
+	shear_vertex(r, &m->pos[3 * m->tris[prim].v[1]], v[1]);
+	shear_vertex(r, &m->pos[3 * m->tris[prim].v[2]], v[2]);
+	e[0] = v[2][0] * v[1][1] - v[2][1] * v[1][0];
+	e[1] = v[0][0] * v[2][1] - v[0][1] * v[2][0];
+	e[2] = v[1][0] * v[0][1] - v[1][1] * v[0][0];
+	if (e[0] == 0.0f || e[1] == 0.0f || e[2] == 0.0f)
+	{
+		e[0] = (double)v[2][0] * v[1][1] - (double)v[2][1] * v[1][0];
+		e[1] = (double)v[0][0] * v[2][1] - (double)v[0][1] * v[2][0];
+		e[2] = (double)v[1][0] * v[0][1] - (double)v[1][1] * v[0][0];
+	}
+	if ((e[0] < 0.0f || e[1] < 0.0f || e[2] < 0.0f)
+		&& (e[0] > 0.0f || e[1] > 0.0f || e[2] > 0.0f))
+		return (false);
+	det = e[0] + e[1] + e[2];
+	if (det == 0.0f)
+		return (false);
+	t = (e[0] * v[0][2] + e[1] * v[1][2] + e[2] * v[2][2]) / det;
+	if (!(t > r->t_min && t < r->t_max))
+		return (false);
+	*h = (t_mesh_hit){t, prim, e[1] / det, e[2] / det};
+	return (true);
+}
+
+static void	add_crossing(t_mesh_query *q, t_mesh_hit *h)
+{
+	t_inters	*x;
+
+	x = new_intersection(h->t, q->obj);
+	if (!x)
+		return ;
+	x->prim = h->prim;
+	x->u = h->u;
+	x->v = h->v;
+	ft_add_intersection(q->xs, x);
+	q->found = true;
+}
+
+/*
+** Tests a leaf's triangles; true when the query is answered and the
+** traversal can stop (MESH_ANY found a blocker).
+*/
+static bool	visit_leaf(t_mesh_data *m, const t_bvh_node *n, t_mesh_query *q)
+{
+	t_mesh_hit	h;
+	int			i;
+
+	i = n->start - 1;
+	while (++i < n->start + n->count)
+	{
+		if (!hit_triangle(m, &q->ray, i, &h))
+			continue ;
+		if (q->mode == MESH_ANY)
+		{
+			if (h.t > adaptive_epsilon(h.t))
+				return (q->found = true, true);
+		}
+		else if (q->mode == MESH_NEAREST)
+		{
+			q->hit = h;
+			q->ray.t_max = h.t;
+			q->found = true;
+		}
+		else
+			add_crossing(q, &h);
+	}
+	return (false);
+}
+
+/*
+** Next node to visit below inner node n, nearer child first; the other
+** child, if the ray enters it too, waits on the stack with its entry
+** distance. -1 when the ray misses both.
+*/
+static int	descend(t_mesh_data *m, t_mesh_query *q, const t_bvh_node *n,
+	t_bvh_stack *st)
+{
+	float	t[2];
+	bool	in[2];
+	int		near;
+
+	in[0] = bvh_hit_node(&m->nodes[n->start], &q->ray, &t[0]);
+	in[1] = bvh_hit_node(&m->nodes[n->start + 1], &q->ray, &t[1]);
+	if (!in[0] && !in[1])
+		return (-1);
+	if (!in[1])
+		return (n->start);
+	if (!in[0])
+		return (n->start + 1);
+	near = (t[1] < t[0]);
+	st->node[st->size] = n->start + !near;
+	st->enter[st->size++] = t[!near];
+	return (n->start + near);
+}
+
+static void	traverse(t_mesh_data *m, t_mesh_query *q)
+{
+	t_bvh_stack	st;
+	float		t;
+	int			node;
+
+	st.size = 0;
+	node = 0;
+	if (!bvh_hit_node(&m->nodes[0], &q->ray, &t))
+		return ;
+	while (1)
+	{
+		if (m->nodes[node].count == 0)
+			node = descend(m, q, &m->nodes[node], &st);
+		else if (visit_leaf(m, &m->nodes[node], q))
+			return ;
+		else
+			node = -1;
+		while (node < 0 && st.size > 0)
+		{
+			st.size--;
+			if (st.enter[st.size] <= q->ray.t_max)
+				node = st.node[st.size];
+		}
+		if (node < 0)
+			return ;
+	}
+}
+
+/*
+** ray is already in mesh space. An opaque mesh reports its nearest hit in
+** front of the origin. A transparent one reports every crossing along the
+** whole line, like the sphere does, so compute_n1_n2 can tell from the
+** hits behind the origin whether a ray starts inside it.
+*/
+bool	intersect_mesh(t_mesh *me, t_ray ray, t_inters **xs, t_object *obj)
+{
+	t_mesh_query	q;
+
+	q.mode = MESH_NEAREST;
+	q.ray = bvh_ray(ray, 0.0f, INFINITY);
+	if (me->material.transparency > 0.0)
+	{
+		q.mode = MESH_ALL;
+		q.ray = bvh_ray(ray, -INFINITY, INFINITY);
+	}
+	q.found = false;
+	q.xs = xs;
+	q.obj = obj;
+	traverse(me->geo, &q);
+	if (q.mode == MESH_NEAREST && q.found)
+		add_crossing(&q, &q.hit);
+	return (q.found);
+}
+
+/*
+** Any-hit query for shadow rays (mesh space), stopping at the first
+** triangle between the surface and the light.
+*/
+bool	mesh_occludes(t_mesh *me, t_ray ray, float max_distance)
+{
+	t_mesh_query	q;
+
+	q.mode = MESH_ANY;
+	q.ray = bvh_ray(ray, 0.0f, max_distance);
+	q.found = false;
+	q.xs = NULL;
+	q.obj = NULL;
+	traverse(me->geo, &q);
+	return (q.found);
+}
@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 07:16:17 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 12:36:30 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -35,6 +35,8 @@ t_material	material(void)
 	mat.has_bump_map = false;
 	mat.has_normal_map = false;
 	mat.has_color_texture = false;
+	mat.casts_shadow = true;
+	mat.receives_shadow = true;
 	return (mat);
 }
 
@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   area_light_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 11:20:27 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 11:20:27 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+/*
+** Strata of the AREA_GRID x AREA_GRID grid in the order they are tried.
+** The first AREA_PROBES form a rotated grid, one per quadrant and never
+** two in a row or column, so they spread over the whole light.
+*/
+static const int	g_strata[AREA_GRID * AREA_GRID] = {
+	4, 2, 13, 11, 0, 1, 3, 5, 6, 7, 8, 9, 10, 12, 14, 15
+};
+
+/*
+** Radius of a sphere around origin holding the whole light.
+*/
+float	light_extent(t_light *light)
+{
+	if (light->kind == LIGHT_RECT)
+		return (0.5f * sqrtf(vecs_dot_product(light->u, light->u)
+				+ vecs_dot_product(light->v, light->v)));
+	if (light->kind == LIGHT_SPHERE)
+		return (light->radius);
+	return (0.0f);
+}
+
+/*
+** Maps (s, t) in [0, 1)² onto the light. A sphere is seen from point as
+** the disc through its centre facing point, so that disc is sampled.
+*/
+static t_tuple	light_point(t_light *light, t_tuple point, float s, float t)
+{
+	t_tuple	w;
+	t_tuple	a;
+	t_tuple	b;
+	float	r;
+
+	if (light->kind == LIGHT_RECT)
+		return (add_tuple(light->origin, add_tuple(
+					tuple_scalar_mult(light->u, s - 0.5f),
+					tuple_scalar_mult(light->v, t - 0.5f))));
+	w = normalizing_vector(substract_tuple(light->origin, point));
+	a = (t_tuple){1, 0, 0, 0};
+	if (fabsf(w.x) > 0.9f)
+		a = (t_tuple){0, 1, 0, 0};
+	a = normalizing_vector(vecs_cross_product(w, a));
+	b = vecs_cross_product(w, a);
+	r = light->radius * sqrtf(s);
+	t *= 2.0f * M_PI;
+	return (add_tuple(light->origin, add_tuple(tuple_scalar_mult(a,
+					r * cosf(t)), tuple_scalar_mult(b, r * sinf(t)))));
+}
+
+/*
+** One shadow ray to a jittered point of stratum k; 1 when it gets through.
+*/
+static int	stratum_clear(t_world *world, t_tuple point, t_light *light,
+	int k)
+{
+	float	s;
+	float	t;
+
+	s = (g_strata[k] % AREA_GRID + hash_random(point, 2 * k + 1)) / AREA_GRID;
+	t = (g_strata[k] / AREA_GRID + hash_random(point, 2 * k + 2)) / AREA_GRID;
+	return (!shadowed_from(*world, point, light_point(light, point, s, t),
+			light));
+}
+
+/*
+** Share of the light point sees, in [0, 1]. Point lights are 0 or 1. An
+** area light first gets AREA_PROBES rays; if they agree the point is lit
+** or in umbra and that is the answer. Only in a penumbra, where they
+** disagree, are the other strata traced.
+*/
+float	light_visibility(t_world *world, t_tuple point, t_light *light)
+{
+	int	clear;
+	int	k;
+
+	if (light->kind == LIGHT_POINT)
+		return (!is_shadowed(*world, point, light));
+	clear = 0;
+	k = 0;
+	while (k < AREA_PROBES)
+		clear += stratum_clear(world, point, light, k++);
+	if (clear == 0 || clear == AREA_PROBES)
+		return ((float)clear / AREA_PROBES);
+	while (k < AREA_GRID * AREA_GRID)
+		clear += stratum_clear(world, point, light, k++);
+	return ((float)clear / (AREA_GRID * AREA_GRID));
+}
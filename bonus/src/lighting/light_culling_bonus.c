@@ -0,0 +1,150 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   light_culling_bonus.c                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 12:07:38 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 12:18:11 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+/*
+** A plane is y = 0 in object space, so its world normal is the second row
+** of trans_inv and its origin the translation column of trans.
+*/
+static t_tuple	plane_normal(t_plane *pl)
+{
+	return (normalizing_vector((t_tuple){pl->trans_inv.mtrx[1][0],
+			pl->trans_inv.mtrx[1][1], pl->trans_inv.mtrx[1][2], 0}));
+}
+
+/*
+** Which side of the plane p lies on: 1 in front of its normal, -1 behind,
+** 0 within radius of it.
+*/
+static int	side_of(t_plane *pl, t_tuple p, float radius)
+{
+	t_tuple	normal;
+	t_tuple	origin;
+	float	d;
+
+	origin = (t_tuple){pl->trans.mtrx[0][3], pl->trans.mtrx[1][3],
+		pl->trans.mtrx[2][3], 1};
+	normal = plane_normal(pl);
+	d = vecs_dot_product(substract_tuple(p, origin), normal);
+	if (d - radius > PLANE_EPSILON)
+		return (1);
+	if (d + radius < -PLANE_EPSILON)
+		return (-1);
+	return (0);
+}
+
+/*
+** Side of a whole object. Bounded objects use their box: its half extents
+** projected on the normal give the radius the centre must clear. Other
+** planes only count when parallel; anything else unbounded straddles.
+*/
+static int	object_side(t_plane *pl, t_object *obj)
+{
+	t_tuple	n;
+	t_tuple	c;
+	t_tuple	h;
+	t_plane	*other;
+
+	if (obj->bounds.finite)
+	{
+		n = plane_normal(pl);
+		c = tuple_scalar_mult(add_tuple(obj->bounds.min, obj->bounds.max), 0.5f);
+		h = tuple_scalar_mult(substract_tuple(obj->bounds.max,
+					obj->bounds.min), 0.5f);
+		c.w = 1;
+		return (side_of(pl, c, fabsf(n.x) * h.x + fabsf(n.y) * h.y
+				+ fabsf(n.z) * h.z));
+	}
+	if (obj->type != OBJ_PLANE)
+		return (0);
+	other = &obj->shape.pl;
+	if (fabsf(vecs_dot_product(plane_normal(pl), plane_normal(other)))
+		< 1.0f - PLANE_EPSILON)
+		return (0);
+	return (side_of(pl, (t_tuple){other->trans.mtrx[0][3],
+			other->trans.mtrx[1][3], other->trans.mtrx[2][3], 1}, 0));
+}
+
+/*
+** A plane only shadows points on its far side from the light. If it is
+** opaque and the light and eye are on the same side, a ray can only get to
+** the far side through a transparent object crossing the plane. Without
+** one, the plane can never occlude this light. An area light has to be
+** wholly on one side. Transparent instances are not checked one by one:
+** any of them keeps every plane.
+*/
+static bool	can_occlude(t_world *world, t_object *obj, t_light *light,
+	t_tuple eye)
+{
+	t_object	*other;
+	int			side;
+
+	if (!object_material(obj)->casts_shadow)
+		return (false);
+	if (obj->type != OBJ_PLANE || object_material(obj)->transparency > 0.0)
+		return (true);
+	side = side_of(&obj->shape.pl, light->origin, light_extent(light));
+	if (side == 0 || side_of(&obj->shape.pl, eye, 0) != side
+		|| (world->instances && world->instances->transparent))
+		return (true);
+	other = world->objects;
+	while (other)
+	{
+		if (other != obj && object_material(other)->transparency > 0.0
+			&& object_side(&obj->shape.pl, other) != side)
+			return (true);
+		other = other->next;
+	}
+	return (false);
+}
+
+/*
+** Gives each light the NULL-terminated list of objects its shadow rays have
+** to test. If an allocation fails that light keeps NULL and is_shadowed
+** falls back to walking every object. Calling it again for a new eye
+** replaces the previous lists.
+*/
+void	build_light_occluders(t_world *world, t_tuple eye)
+{
+	t_light		*light;
+	t_object	*obj;
+	int			total;
+	int			count;
+	uint64_t	start;
+
+	start = prof_now();
+	total = 0;
+	obj = world->objects;
+	while (obj && ++total)
+		obj = obj->next;
+	light = world->lights;
+	while (light)
+	{
+		free(light->occluders);
+		light->occluders = malloc(sizeof(t_object *) * (total + 1));
+		if (light->occluders)
+		{
+			count = 0;
+			obj = world->objects;
+			while (obj)
+			{
+				if (can_occlude(world, obj, light, eye))
+					light->occluders[count++] = obj;
+				obj = obj->next;
+			}
+			light->occluders[count] = NULL;
+		}
+		light = light->next;
+	}
+	prof_span("build_occluders", start, -1);
+}
@@ -0,0 +1,163 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   light_sampling_bonus.c                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 09:32:12 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 12:25:24 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+typedef enum e_light_pass
+{
+	PASS_COUNT,
+	PASS_SHADE,
+	PASS_PICK
+}	t_light_pass;
+
+/*
+** State of one walk over the lights reaching a hit. PASS_COUNT sums their
+** weights, PASS_SHADE shades each of them and PASS_PICK shades the ones
+** the evenly spaced marks next, next + step, ... land on.
+*/
+typedef struct s_light_walk
+{
+	t_world			*world;
+	t_comps			*comp;
+	t_light_pass	pass;
+	int				count;
+	float			total;
+	float			seen;
+	float			next;
+	float			step;
+	t_tuple			color;
+}	t_light_walk;
+
+/*
+** Stateless number in [0, 1) from a hit point and a salt telling apart the
+** numbers one hit needs, so a frame renders the same way on any thread.
+*/
+float	hash_random(t_tuple p, uint32_t salt)
+{
+	uint32_t	bits[3];
+	uint32_t	h;
+	int			i;
+
+	ft_memcpy(&bits[0], &p.x, sizeof(float));
+	ft_memcpy(&bits[1], &p.y, sizeof(float));
+	ft_memcpy(&bits[2], &p.z, sizeof(float));
+	h = 2166136261u ^ salt;
+	i = -1;
+	while (++i < 3)
+	{
+		h = (h ^ bits[i]) * 16777619u;
+		h ^= h >> 15;
+	}
+	h *= 0x2c1b3c6du;
+	h ^= h >> 12;
+	return ((h >> 8) * (1.0f / 16777216.0f));
+}
+
+/*
+** A light picked with probability weight / total is shaded scaled by
+** total / (samples * weight), which keeps the sum unbiased. Marks are
+** step = total / samples apart, so a strong light can be picked twice.
+*/
+static void	visit_light(t_light_walk *w, t_light *light)
+{
+	float	falloff;
+	float	weight;
+
+	falloff = light_falloff(light, w->comp->over_point);
+	weight = light_peak(light) * falloff;
+	if (falloff <= 0.0f || weight < w->world->trace.light_cutoff)
+		return ;
+	w->count++;
+	if (w->pass == PASS_COUNT)
+		w->total += weight;
+	else if (w->pass == PASS_SHADE)
+		w->color = add_tuple(w->color,
+				shade_light(w->world, w->comp, light, falloff));
+	w->seen += weight;
+	while (w->pass == PASS_PICK && w->next < w->seen)
+	{
+		w->color = add_tuple(w->color, shade_light(w->world, w->comp, light,
+					falloff * w->step / weight));
+		w->next += w->step;
+	}
+}
+
+static bool	visit_leaf(void *ctx, const t_bvh_node *leaf)
+{
+	t_light_walk	*w;
+	int				i;
+
+	w = ctx;
+	i = -1;
+	while (++i < leaf->count)
+		visit_light(w, w->world->light_tree->ranged[leaf->start + i]);
+	return (false);
+}
+
+static void	walk_lights(t_light_walk *w, t_light_pass pass)
+{
+	t_light_tree	*tree;
+	float			p[3];
+	int				i;
+
+	tree = w->world->light_tree;
+	w->pass = pass;
+	w->count = 0;
+	w->seen = 0.0f;
+	i = -1;
+	while (++i < tree->all_count)
+		visit_light(w, tree->all[i]);
+	if (tree->ranged_count == 0)
+		return ;
+	p[0] = w->comp->over_point.x;
+	p[1] = w->comp->over_point.y;
+	p[2] = w->comp->over_point.z;
+	bvh_query(tree->nodes, p, visit_leaf, w);
+}
+
+/*
+** Adds the light every light brings to the hit to color. Only lights that
+** reach the hit are looked at. With --light-samples n and more than n of
+** them, n are picked in proportion to their contribution instead.
+*/
+t_tuple	direct_lighting(t_world *world, t_comps *comp, t_tuple color)
+{
+	t_light_walk	w;
+	t_light			*light;
+	int				samples;
+
+	if (!world->light_tree)
+	{
+		light = world->lights;
+		while (light)
+		{
+			if (light_falloff(light, comp->over_point) > 0.0f)
+				color = add_tuple(color, shade_light(world, comp, light,
+							light_falloff(light, comp->over_point)));
+			light = light->next;
+		}
+		return (color);
+	}
+	w = (t_light_walk){.world = world, .comp = comp, .color = color};
+	samples = world->trace.light_samples;
+	if (samples > 0)
+		walk_lights(&w, PASS_COUNT);
+	if (samples == 0 || w.count <= samples)
+		walk_lights(&w, PASS_SHADE);
+	else
+	{
+		w.step = w.total / samples;
+		w.next = hash_random(comp->over_point, 0) * w.step;
+		walk_lights(&w, PASS_PICK);
+	}
+	return (w.color);
+}
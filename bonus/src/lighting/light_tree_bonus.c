@@ -0,0 +1,140 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   light_tree_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 09:24:59 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 09:24:59 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+/*
+** Largest contribution the light can make: its brightness times its
+** strongest channel, reached right next to it.
+*/
+float	light_peak(t_light *light)
+{
+	return (light->brightness * bvh_max(light->color.x,
+			bvh_max(light->color.y, light->color.z)));
+}
+
+/*
+** Share of the light left at point: (1 - d²/range²)², which is smooth and
+** exactly 0 from range on. Lights without a range never fade.
+*/
+float	light_falloff(t_light *light, t_tuple point)
+{
+	t_tuple	v;
+	float	x;
+
+	if (light->range <= 0.0f)
+		return (1.0f);
+	v = substract_tuple(light->origin, point);
+	x = vecs_dot_product(v, v) / (light->range * light->range);
+	if (x >= 1.0f)
+		return (0.0f);
+	return ((1.0f - x) * (1.0f - x));
+}
+
+/*
+** Box around the distance at which the light's contribution drops under
+** the cutoff: peak * (1 - x)² = cutoff gives x = 1 - sqrt(cutoff / peak).
+*/
+static void	light_ref(t_light *light, float cutoff, int index, t_bvh_ref *r)
+{
+	float	reach;
+	int		k;
+
+	reach = light->range * sqrtf(1.0f - sqrtf(cutoff / light_peak(light)));
+	r->index = index;
+	k = -1;
+	while (++k < 3)
+	{
+		r->cen[k] = (&light->origin.x)[k];
+		r->box[k] = r->cen[k] - reach;
+		r->box[k + 3] = r->cen[k] + reach;
+	}
+}
+
+/*
+** Sorts the lights into the tree's two groups, leaving out those that
+** stay under the cutoff everywhere. ranged holds the build list until the
+** BVH is built, then the lights in leaf order.
+*/
+static bool	sort_lights(t_light_tree *tree, t_light *lights, float cutoff,
+	t_bvh_ref *refs)
+{
+	t_light	**list;
+	int		i;
+
+	list = tree->ranged;
+	while (lights)
+	{
+		if (light_peak(lights) >= cutoff && lights->range <= 0.0f)
+			tree->all[tree->all_count++] = lights;
+		else if (light_peak(lights) >= cutoff && light_peak(lights) > 0.0f)
+		{
+			light_ref(lights, cutoff, tree->ranged_count,
+				&refs[tree->ranged_count]);
+			list[tree->ranged_count++] = lights;
+		}
+		lights = lights->next;
+	}
+	if (tree->ranged_count == 0)
+		return (true);
+	tree->ranged = malloc(sizeof(t_light *) * tree->ranged_count);
+	if (tree->ranged)
+		tree->node_count = bvh_build(refs, tree->ranged_count, &tree->nodes);
+	i = -1;
+	while (tree->node_count > 0 && ++i < tree->ranged_count)
+		tree->ranged[i] = list[refs[i].index];
+	free(list);
+	return (tree->node_count > 0);
+}
+
+void	free_light_tree(t_light_tree *tree)
+{
+	free(tree->all);
+	free(tree->ranged);
+	free(tree->nodes);
+	*tree = (t_light_tree){};
+}
+
+/*
+** (Re)builds the tree for lights. On failure the tree is left empty and
+** the caller should shade with every light instead.
+*/
+bool	build_light_tree(t_light_tree *tree, t_light *lights, float cutoff)
+{
+	t_light		*light;
+	t_bvh_ref	*refs;
+	int			count;
+	bool		ok;
+	uint64_t	start;
+
+	start = prof_now();
+	free_light_tree(tree);
+	count = 0;
+	light = lights;
+	while (light && ++count)
+		light = light->next;
+	tree->all = malloc(sizeof(t_light *) * (count + 1));
+	tree->ranged = malloc(sizeof(t_light *) * (count + 1));
+	refs = malloc(sizeof(t_bvh_ref) * (count + 1));
+	ok = tree->all && tree->ranged && refs
+		&& sort_lights(tree, lights, cutoff, refs);
+	free(refs);
+	if (!ok)
+		free_light_tree(tree);
+	if (!ok)
+		printf("❌ Lights: Out of memory building the light tree\n");
+	else if (tree->ranged_count > 0)
+		printf("✅ Lights: %d ranged in %d BVH nodes, %d everywhere\n",
+			tree->ranged_count, tree->node_count, tree->all_count);
+	prof_span("build_light_tree", start, -1);
+	return (ok);
+}
@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 07:16:17 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 00:27:04 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,17 +14,32 @@
 
 static void	handle_screenshot(t_data *data)
 {
-	if (data->img && data->state == STATE_DISPLAY)
-	{
-		mlx_image_to_ppm(data->img, "screenshot.ppm", 255);
-		printf("📸 Screenshot saved to screenshot.ppm\n");
-	}
-	else if (data->img && data->render_mode == MODE_PREVIEW
-		&& data->render_complete)
-	{
-		mlx_image_to_ppm(data->img, "screenshot.ppm", 255);
-		printf("📸 Screenshot saved to screenshot.ppm\n");
-	}
+	uint64_t	start;
+
+	if (!data->img || !(data->state == STATE_DISPLAY
+			|| (data->render_mode == MODE_PREVIEW && data->render_complete)))
+		return ;
+	start = prof_now();
+	mlx_image_to_ppm(data->img, "screenshot.ppm", 255);
+	framebuffer_to_pfm(&data->fb, "screenshot.pfm");
+	prof_span("export", start, -1);
+	printf("📸 Screenshot saved to screenshot.ppm (+ .pfm)\n");
+	if (data->opts.heatmap && heatmap_write(&data->heat))
+		printf("📸 Heatmaps saved to heat_<metric>.ppm\n");
+}
+
+/*
+** H steps through the render and each cost map (--heatmap only).
+*/
+static void	handle_heatmap(t_data *data)
+{
+	t_heat	next;
+
+	if (!data->opts.heatmap || data->state != STATE_DISPLAY)
+		return ;
+	next = (data->heat.shown + 1) % HEAT_VIEWS;
+	heatmap_show(&data->heat, &data->fb, data->img, next);
+	printf("🔥 Showing %s\n", heat_name(next));
 }
 
 static void	handle_space(t_data *data)
@@ -56,35 +71,74 @@ void	key_hook(mlx_key_data_t keydata, void *param)
 		handle_screenshot(data);
 	else if (keydata.key == MLX_KEY_SPACE)
 		handle_space(data);
+	else if (keydata.key == MLX_KEY_R && data->state == STATE_DISPLAY)
+		reload_scene(data);
+	else if (keydata.key == MLX_KEY_H)
+		handle_heatmap(data);
 }
 
-void	loop_hook(void *param)
+/*
+** Re-traces only the dragged rectangle; the rest of the image keeps the
+** previous frame.
+*/
+static void	render_region(t_data *data, t_tile region)
+{
+	data->opts.job.region = region;
+	if (!restart_render(data))
+		return ;
+	printf("🔍 Re-rendering %dx%d at (%d, %d): %d tiles\n", region.w,
+		region.h, region.x, region.y, data->total_tiles);
+}
+
+void	mouse_hook(mouse_key_t button, action_t action, modifier_key_t mods,
+		void *param)
 {
 	t_data	*data;
-	int		i;
+	int32_t	to[2];
+	t_tile	region;
+
+	(void)mods;
+	data = (t_data *)param;
+	if (button != MLX_MOUSE_BUTTON_LEFT || data->state != STATE_DISPLAY)
+		return ;
+	if (action == MLX_PRESS)
+	{
+		mlx_get_mouse_pos(data->ptr, &data->drag_from[0], &data->drag_from[1]);
+		data->dragging = true;
+	}
+	else if (action == MLX_RELEASE && data->dragging)
+	{
+		data->dragging = false;
+		mlx_get_mouse_pos(data->ptr, &to[0], &to[1]);
+		region = span_region(data->drag_from, to, data->fb.width,
+				data->fb.height);
+		if (region.w >= MIN_DRAG && region.h >= MIN_DRAG)
+			render_region(data, region);
+	}
+}
+
+void	loop_hook(void *param)
+{
+	t_data		*data;
+	uint64_t	start;
 
 	data = (t_data *)param;
+	if (data->watch_fd >= 0 && watch_poll(data))
+		reload_scene(data);
 	if (data->state != STATE_RENDERING)
 		return ;
+	start = prof_now();
+	if (data->opts.heatmap && data->tiles_done >= data->total_tiles
+		&& !data->render_complete)
+	{
+		heatmap_report(&data->heat);
+		heatmap_show(&data->heat, &data->fb, data->img, data->opts.heatmap);
+	}
 	if (data->render_mode == MODE_LOAD)
 		update_progress_bar(data);
-	if (data->lines_done >= data->total_lines && !data->render_complete)
+	if (data->tiles_done >= data->total_tiles && !data->render_complete)
 	{
-		if (data->threads_started)
-		{
-			i = 0;
-			while (i < NUM_THREADS)
-			{
-				pthread_join(data->threads[i], NULL);
-				i++;
-			}
-			data->threads_started = false;
-		}
-		if (data->mutex_initialized)
-		{
-			pthread_mutex_destroy(&data->render_mutex);
-			data->mutex_initialized = false;
-		}
+		stop_threaded_render(data);
 		data->render_complete = true;
 		if (data->render_mode == MODE_PREVIEW)
 		{
@@ -97,50 +151,112 @@ void	loop_hook(void *param)
 			printf("✅ Rendering complete! Press SPACE to view\n");
 		}
 	}
+	prof_span("loop_hook", start, -1);
 }
 
 int	setup_world(t_data *data, t_camera *cam)
 {
+	uint64_t	start;
+
+	start = prof_now();
+	if (data->opts.job.has_camera)
+	{
+		data->cam.from = data->opts.job.eye;
+		data->cam.to = add_tuple(data->cam.from,
+				normalizing_vector(data->opts.job.dir));
+		data->cam.up = (t_tuple){0, 1, 0, 0};
+		data->cam.fov = data->opts.job.fov;
+	}
 	data->world = new_world();
 	data->world.objects = data->object;
+	data->world.instances = &data->instances;
 	data->world.lights = data->light;
 	data->world.ambient_color = data->ambl.color;
-	*cam = camera(1920, 1080, data->cam.fov * M_PI / 180.0);
+	data->world.trace = data->opts.job.trace;
+	if (build_light_tree(&data->light_tree, data->light,
+			data->world.trace.light_cutoff))
+		data->world.light_tree = &data->light_tree;
+	build_light_occluders(&data->world, data->cam.from);
+	*cam = camera(data->opts.job.width, data->opts.job.height,
+			data->cam.fov * M_PI / 180.0);
 	cam->transform = view_transformation(data->cam.from, data->cam.to,
 			data->cam.up);
+	cam->from = data->cam.from;
+	cam->to = data->cam.to;
+	cam->up = data->cam.up;
 	data->cam = *cam;
+	prof_span("setup_world", start, -1);
 	return (1);
 }
 
-void	free_objects_and_lights(t_data *data)
+static void	free_object_list(t_object *obj, t_tex_cache *textures)
 {
-	t_object	*obj;
-	t_object	*next_obj;
-	t_light		*light;
-	t_light		*next_light;
-
-	obj = data->object;
 	while (obj)
 	{
-		next_obj = obj->next;
 		if (obj->type == OBJ_SPHERE)
-			free_material_textures(&obj->shape.sp.material);
+			free_material_textures(&obj->shape.sp.material, textures);
 		else if (obj->type == OBJ_PLANE)
-			free_material_textures(&obj->shape.pl.material);
+			free_material_textures(&obj->shape.pl.material, textures);
 		else if (obj->type == OBJ_CYLINDER)
-			free_material_textures(&obj->shape.cy.material);
+			free_material_textures(&obj->shape.cy.material, textures);
 		else if (obj->type == OBJ_CONE)
-			free_material_textures(&obj->shape.co.material);
-		free(obj);
-		obj = next_obj;
+			free_material_textures(&obj->shape.co.material, textures);
+		else if (obj->type == OBJ_MESH)
+		{
+			free_material_textures(&obj->shape.me.material, textures);
+			mesh_free(obj->shape.me.geo);
+		}
+		obj = obj->next;
 	}
+}
+
+static void	free_instances(t_instances *set, t_tex_cache *textures)
+{
+	t_proto	*proto;
+	t_proto	*next_proto;
+
+	proto = set->protos;
+	while (proto)
+	{
+		next_proto = proto->next;
+		free_object_list(proto->members, textures);
+		free(proto->name);
+		free(proto->order);
+		free(proto->nodes);
+		free(proto);
+		proto = next_proto;
+	}
+	free(set->items);
+	free(set->refs);
+	free(set->nodes);
+	*set = (t_instances){};
+}
+
+/*
+** Objects, prototype members and lights live in the two scene arenas: the
+** walks only release what they point at, the nodes go with the arenas.
+** Safe to call twice.
+*/
+void	free_objects_and_lights(t_data *data)
+{
+	t_light		*light;
+
+	free_object_list(data->object, data->textures);
+	free_instances(&data->instances, data->textures);
+	free_light_tree(&data->light_tree);
+	anim_free(&data->anim);
 	light = data->light;
 	while (light)
 	{
-		next_light = light->next;
-		free(light);
-		light = next_light;
+		free(light->occluders);
+		light = light->next;
 	}
+	arena_free(&data->arena);
+	arena_free(&data->light_arena);
+	data->object = NULL;
+	data->object_last = NULL;
+	data->light = NULL;
+	data->light_last = NULL;
 }
 
 static int	get_mode_selection(void)
@@ -161,6 +277,9 @@ static int	get_mode_selection(void)
 	printf("║      Progress bar + SPACE to reveal    ║\n");
 	printf("╠════════════════════════════════════════╣\n");
 	printf("║  Controls: ESC=Exit  T=Screenshot      ║\n");
+	printf("║  Drag a box: re-render just that area  ║\n");
+	printf("║  R: reload the scene file              ║\n");
+	printf("║  H: cycle cost heatmaps (--heatmap)    ║\n");
 	printf("╚════════════════════════════════════════╝\n");
 	printf("Enter mode (1 or 2): ");
 	fflush(stdout);
@@ -184,7 +303,9 @@ static int	init_preview_mode(t_data *data)
 		return (mlx_terminate(data->ptr), 0);
 	mlx_image_to_window(data->ptr, data->img, 0, 0);
 	data->state = STATE_RENDERING;
-	start_threaded_render(data);
+	if (!start_threaded_render(data))
+		return (mlx_delete_image(data->ptr, data->img),
+			mlx_terminate(data->ptr), 0);
 	printf("🎬 Preview mode: Rendering with %d threads...\n", NUM_THREADS);
 	return (1);
 }
@@ -204,7 +325,9 @@ static int	init_load_mode(t_data *data)
 	draw_front_page(data);
 	draw_progress_bar(data);
 	data->state = STATE_RENDERING;
-	start_threaded_render(data);
+	if (!start_threaded_render(data))
+		return (mlx_delete_image(data->ptr, data->img),
+			mlx_terminate(data->ptr), 0);
 	printf("📊 Load mode: Rendering with %d threads...\n", NUM_THREADS);
 	return (1);
 }
@@ -212,17 +335,48 @@ static int	init_load_mode(t_data *data)
 int	main(int argc, char **argv)
 {
 	t_data		data;
+	t_tex_cache	textures;
 	t_camera	cam;
+	int			status;
 
+	prof_thread("main");
 	data = (t_data){};
-	if (argc != 2)
+	textures = (t_tex_cache){};
+	data.textures = &textures;
+	data.watch_fd = -1;
+	if (!parse_options(argc, argv, &data.opts))
 	{
-		printf("❌ Usage: %s <scene_file.rt>\n", argv[0]);
+		printf("❌ Usage: %s <scene_file.rt> [--rr] [--min-weight <w>] "
+			"[--light-cutoff <c>] [--light-samples <n>] "
+			"[--size <w>x<h>] [--workers <n>] [--listen <addr>] "
+			"[--output <file>] [--tile-timeout <s>] [--samples <n>] "
+			"[--camera <x,y,z,dx,dy,dz,fov>] [--region <x,y,w,h>] "
+			"[--checkpoint <f>] [--checkpoint-every <s>] [--resume] "
+			"[--gbuffer] [--heatmap <metric>] [--connect <addr>] "
+			"[--frames <n>] [--fps <f>]\n"
+			"          %s --worker <addr> | --serve <addr>\n",
+			argv[0], argv[0]);
 		return (1);
 	}
-	if (!complete_parsing(argv[1], &data))
+	if (data.opts.worker)
+		return (run_worker(&data.opts));
+	if (data.opts.serve)
+		return (run_server(&data.opts));
+	if (data.opts.connect)
+		return (run_client(&data.opts));
+	if (!complete_parsing(data.opts.scene, &data))
 		return (1);
 	printf("✅ Parsing completed successfully!\n");
+	if (data.opts.frames > 0)
+	{
+		status = run_frames(&data);
+		return (free_objects_and_lights(&data), status);
+	}
+	if (data.opts.workers > 0 || data.opts.listen)
+	{
+		status = run_coordinator(&data);
+		return (free_objects_and_lights(&data), status);
+	}
 	data.render_mode = get_mode_selection();
 	setup_world(&data, &cam);
 	if (data.render_mode == MODE_PREVIEW)
@@ -235,12 +389,21 @@ int	main(int argc, char **argv)
 		if (!init_load_mode(&data))
 			return (free_objects_and_lights(&data), 1);
 	}
+	if (watch_start(&data))
+		printf("👀 Watching %s for changes\n", data.opts.scene);
 	mlx_key_hook(data.ptr, key_hook, &data);
+	mlx_mouse_hook(data.ptr, mouse_hook, &data);
 	mlx_loop_hook(data.ptr, loop_hook, &data);
 	mlx_loop(data.ptr);
 	if (data.state == STATE_RENDERING)
 		stop_threaded_render(&data);
+	watch_stop(&data);
 	free_objects_and_lights(&data);
+	framebuffer_free(&data.fb);
+	gbuffer_free(&data.gbuf);
+	heatmap_free(&data.heat);
+	free(data.tile_done);
+	free(data.visible);
 	if (data.img)
 		mlx_delete_image(data.ptr, data.img);
 	mlx_terminate(data.ptr);
@@ -0,0 +1,156 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   anim_extract_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 12:54:16 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 18:04:35 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+static bool	parse_prop(char *name, t_anim_kind kind, t_anim_prop *prop)
+{
+	if (ft_strncmp(name, "pos", 4) == 0)
+		*prop = PROP_POS;
+	else if (ft_strncmp(name, "look", 5) == 0 && kind == ANIM_CAMERA)
+		*prop = PROP_LOOK;
+	else if (ft_strncmp(name, "rot", 4) == 0 && kind == ANIM_OBJECT)
+		*prop = PROP_ROT;
+	else
+		return (printf("❌ anim: '%s' cannot be animated here (camera: pos, "
+				"look; light: pos; object: pos, rot)\n", name), false);
+	return (true);
+}
+
+static bool	validate_anim(char **fields, int field_count, t_anim_kind kind,
+	t_anim_prop *prop)
+{
+	if (field_count != 6)
+		return (printf("❌ anim: Expected 'anim <time> <prop> x,y,z', got %d "
+				"fields\n", field_count), false);
+	if (ft_strncmp(fields[0], "anim", 5) != 0)
+		return (printf("❌ anim: Invalid identifier '%s'\n", fields[0]), false);
+	if (kind == ANIM_NONE)
+		return (printf("❌ anim: Must follow a C, light or object line\n"),
+			false);
+	if (!f_field_validation(fields[1]) || ft_atof(fields[1]) < 0.0f)
+		return (printf("❌ anim: Invalid time '%s' (seconds >= 0)\n",
+				fields[1]), false);
+	if (!tuple_validator(&fields[3], false, -INFINITY, INFINITY))
+		return (printf("❌ anim: Invalid value: %s,%s,%s\n", fields[3],
+				fields[4], fields[5]), false);
+	return (parse_prop(fields[2], kind, prop));
+}
+
+/*
+** The element the previous line defined: the camera, or the last light or
+** object added. Its pose as parsed is kept as the track's rest pose.
+*/
+static void	track_target(t_data *data, t_track *track)
+{
+	t_light		*light;
+	t_object	*obj;
+	t_matrix	*trans;
+	t_matrix	*inv;
+
+	track->target = &data->cam;
+	track->rest_center = data->cam.from;
+	track->rest_axis = data->cam.to;
+	if (track->kind == ANIM_LIGHT)
+	{
+		light = data->light_last;
+		track->target = light;
+		track->rest_center = light->origin;
+	}
+	else if (track->kind == ANIM_OBJECT)
+	{
+		obj = data->object_last;
+		track->target = obj;
+		object_transforms(obj, &trans, &inv);
+		track->rest = *trans;
+		if (obj->type == OBJ_CONE)
+		{
+			track->rest_center = obj->shape.co.center;
+			track->rest_axis = obj->shape.co.axis;
+		}
+	}
+}
+
+/*
+** The track of that element, created on its first anim line.
+*/
+static t_track	*open_track(t_data *data)
+{
+	t_track	probe;
+	t_track	*track;
+
+	probe = (t_track){.kind = data->anim.last};
+	track_target(data, &probe);
+	track = data->anim.tracks;
+	while (track && track->target != probe.target)
+		track = track->next;
+	if (track)
+		return (track);
+	track = malloc(sizeof(t_track));
+	if (!track)
+		return (NULL);
+	*track = probe;
+	track->next = data->anim.tracks;
+	data->anim.tracks = track;
+	return (track);
+}
+
+static bool	add_key(t_anim *anim, t_track *track, t_anim_prop prop,
+	t_anim_key key)
+{
+	t_anim_key	*keys;
+	int			n;
+
+	n = track->count[prop];
+	if (n > 0 && key.time <= track->keys[prop][n - 1].time)
+		return (printf("❌ anim: Keys of one property must be in time "
+				"order\n"), false);
+	keys = malloc(sizeof(t_anim_key) * (n + 1));
+	if (!keys)
+		return (printf("❌ anim: Out of memory\n"), false);
+	if (n > 0)
+		ft_memcpy(keys, track->keys[prop], sizeof(t_anim_key) * n);
+	keys[n] = key;
+	free(track->keys[prop]);
+	track->keys[prop] = keys;
+	track->count[prop] = n + 1;
+	if (key.time > anim->end)
+		anim->end = key.time;
+	return (true);
+}
+
+/*
+** anim <time> <prop> x,y,z: one keyframe for the element on the line
+** above (further anim lines may sit in between). Positions are points,
+** rot is degrees about x, y and z.
+*/
+bool	anim_extract(char *line, t_data *data)
+{
+	char		**fields;
+	t_anim_prop	prop;
+	t_anim_key	key;
+	t_track		*track;
+
+	fields = ft_split_rt(line, " \t,\n");
+	if (!fields)
+		return (printf("❌ anim: Failed to split line\n"), false);
+	if (!validate_anim(fields, count_fields(fields), data->anim.last, &prop))
+		return (free_matrix(fields), false);
+	key.time = ft_atof(fields[1]);
+	key.value = (t_tuple){ft_atof(fields[3]), ft_atof(fields[4]),
+		ft_atof(fields[5]), prop != PROP_ROT};
+	free_matrix(fields);
+	track = open_track(data);
+	if (!track)
+		return (printf("❌ anim: Out of memory\n"), false);
+	return (add_key(&data->anim, track, prop, key));
+}
@@ -6,25 +6,14 @@
 /*   By: mac <mac@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/01 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2025/12/20 06:40:52 by mac              ###   ########.fr       */
+/*   Updated: 2026/10/19 08:41:41 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "../../includes/miniRT_bonus.h"
 
-/**
- * Applies the ambient light ratio from the parsed data to all objects
- * This ensures all objects use the scene's ambient lighting configuration
- */
-void	apply_ambient_to_objects(t_data *data)
+static void	apply_ambient_to_list(t_object *current, float ambient_ratio)
 {
-	t_object	*current;
-	float		ambient_ratio;
-
-	if (!data || !data->object)
-		return ;
-	ambient_ratio = data->ambl.l_ratio;
-	current = data->object;
 	while (current)
 	{
 		if (current->type == OBJ_SPHERE)
@@ -35,6 +24,28 @@ void	apply_ambient_to_objects(t_data *data)
 			current->shape.cy.material.ambient = ambient_ratio;
 		else if (current->type == OBJ_CONE)
 			current->shape.co.material.ambient = ambient_ratio;
+		else if (current->type == OBJ_MESH)
+			current->shape.me.material.ambient = ambient_ratio;
 		current = current->next;
 	}
 }
+
+/**
+ * Applies the ambient light ratio from the parsed data to all objects,
+ * prototype members included
+ * This ensures all objects use the scene's ambient lighting configuration
+ */
+void	apply_ambient_to_objects(t_data *data)
+{
+	t_proto	*proto;
+
+	if (!data)
+		return ;
+	apply_ambient_to_list(data->object, data->ambl.l_ratio);
+	proto = data->instances.protos;
+	while (proto)
+	{
+		apply_ambient_to_list(proto->members, data->ambl.l_ratio);
+		proto = proto->next;
+	}
+}
@@ -0,0 +1,128 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   area_light_extract_bonus.c                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 11:27:40 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 18:11:48 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+typedef struct s_parser
+{
+	bool	ambl_set;
+	bool	cam_set;
+	bool	light_set;
+	bool	single_light_set;
+}	t_parser;
+
+/*
+** Brightness, colour and optional range, the fields every light line ends
+** with, starting at fields[i]. Both shapes keep their centre in fields 1-3.
+*/
+static t_light	*light_tail(char **fields, int i, char *id, t_arena *arena)
+{
+	t_light	*light;
+	float	range;
+
+	if (!f_field_validation(fields[i])
+		|| !f_range_validator(0.0, 1.0, fields[i]))
+		return (printf("❌ %s: Invalid brightness (0.0 to 1.0): %s\n", id,
+				fields[i]), NULL);
+	if (!tuple_validator(&fields[i + 1], true, 0, 255))
+		return (printf("❌ %s: Invalid color (range 0-255)\n", id), NULL);
+	if (!parse_light_range(fields[i + 4], &range))
+		return (NULL);
+	light = new_light(arena, (t_tuple){ft_atof(fields[1]), ft_atof(fields[2]),
+			ft_atof(fields[3]), 1}, (t_tuple){ft_atoi(fields[i + 1]) / 255.0,
+			ft_atoi(fields[i + 2]) / 255.0, ft_atoi(fields[i + 3]) / 255.0, 0});
+	if (!light)
+		return (printf("❌ %s: Out of memory\n", id), NULL);
+	light->brightness = ft_atof(fields[i]);
+	light->range = range;
+	return (light);
+}
+
+/*
+** rl <x,y,z> <nx,ny,nz> <width> <height> <brightness> <R,G,B> [range:<d>]
+** A rectangle centred on x,y,z and facing n; width runs along what the
+** alignment of +Y onto n makes of +X, height along +Z.
+*/
+static t_light	*rect_light(char **fields, t_arena *arena)
+{
+	t_light		*light;
+	t_matrix	align;
+	t_tuple		n;
+
+	if (!check_fields_num(fields, 13) && !check_fields_num(fields, 14))
+		return (printf("❌ rl: Expected 'rl <x,y,z> <nx,ny,nz> <width> "
+				"<height> <brightness> <R,G,B> [range:<d>]'\n"), NULL);
+	if (!tuple_validator(&fields[1], false, -INFINITY, INFINITY)
+		|| !tuple_validator(&fields[4], false, -1.0, 1.0))
+		return (printf("❌ rl: Invalid position or normal\n"), NULL);
+	n = (t_tuple){ft_atof(fields[4]), ft_atof(fields[5]), ft_atof(fields[6]),
+		0};
+	if (vector_magnitude(n) == 0.0f)
+		return (printf("❌ rl: Normal cannot be zero vector (0,0,0)\n"), NULL);
+	if (!f_field_validation(fields[7]) || !f_field_validation(fields[8])
+		|| ft_atof(fields[7]) <= 0.0f || ft_atof(fields[8]) <= 0.0f)
+		return (printf("❌ rl: Width and height must be > 0\n"), NULL);
+	light = light_tail(fields, 9, "rl", arena);
+	if (!light)
+		return (NULL);
+	align = align_y_to_vector(n);
+	light->kind = LIGHT_RECT;
+	light->u = multiply_matrix_by_tuple(align,
+			(t_tuple){ft_atof(fields[7]), 0, 0, 0});
+	light->v = multiply_matrix_by_tuple(align,
+			(t_tuple){0, 0, ft_atof(fields[8]), 0});
+	return (light);
+}
+
+/*
+** sl <x,y,z> <radius> <brightness> <R,G,B> [range:<d>]
+*/
+static t_light	*sphere_light(char **fields, t_arena *arena)
+{
+	t_light	*light;
+
+	if (!check_fields_num(fields, 9) && !check_fields_num(fields, 10))
+		return (printf("❌ sl: Expected 'sl <x,y,z> <radius> <brightness> "
+				"<R,G,B> [range:<d>]'\n"), NULL);
+	if (!tuple_validator(&fields[1], false, -INFINITY, INFINITY))
+		return (printf("❌ sl: Invalid position\n"), NULL);
+	if (!f_field_validation(fields[4]) || ft_atof(fields[4]) <= 0.0f)
+		return (printf("❌ sl: Radius must be > 0\n"), NULL);
+	light = light_tail(fields, 5, "sl", arena);
+	if (!light)
+		return (NULL);
+	light->kind = LIGHT_SPHERE;
+	light->radius = ft_atof(fields[4]);
+	return (light);
+}
+
+bool	extract_area_light(char *line, t_data *data, t_parser *parser)
+{
+	char	**fields;
+	t_light	*light;
+
+	fields = ft_split_rt(line, " \t,\n");
+	if (!fields)
+		return (false);
+	if (ft_strncmp(fields[0], "rl", 3) == 0)
+		light = rect_light(fields, &data->light_arena);
+	else if (ft_strncmp(fields[0], "sl", 3) == 0)
+		light = sphere_light(fields, &data->light_arena);
+	else
+		return (printf("❌ Invalid identifier '%s'\n", fields[0]),
+			free_matrix(fields), false);
+	if (!light)
+		return (free_matrix(fields), false);
+	ft_add_light(&data->light, &data->light_last, light);
+	parser->light_set = true;
+	return (free_matrix(fields), true);
+}
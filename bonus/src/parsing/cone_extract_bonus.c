@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/20 00:00:00 by mac               #+#    #+#             */
-/*   Updated: 2026/01/03 09:01:42 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 18:19:01 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -98,9 +98,9 @@ bool	cone_extract(char *line, t_data *data)
 	setup_cone_data(&co, fields);
 	color_idx = 10;
 	if (field_count > color_idx + 3
-		&& !parse_material_params(fields, color_idx + 3, &co.material, data->ptr))
+		&& !parse_material_params(fields, color_idx + 3, &co.material, data->textures))
 		return (printf("❌ co: Invalid material params\n"), free_matrix(fields), false);
-	co_obj = new_object(OBJ_CONE, (t_shapes){.co = co});
-	ft_add_object(&data->object, co_obj);
+	co_obj = new_object(&data->arena, OBJ_CONE, (t_shapes){.co = co});
+	ft_add_object(&data->object, &data->object_last, co_obj);
 	return (free_matrix(fields), true);
 }
@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 09:01:42 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 18:26:14 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -84,9 +84,9 @@ bool	cylinder_extract(char *line, t_data *data)
 	cl = cylinder();
 	cl.material = material();
 	setup_cylinder_data(&cl, fields);
-	if (field_count > color_idx + 3 && !parse_material_params(fields, color_idx + 3, &cl.material, data->ptr))
+	if (field_count > color_idx + 3 && !parse_material_params(fields, color_idx + 3, &cl.material, data->textures))
 		return (printf("❌ cy: Invalid material params\n"), free_matrix(fields), false);
-	cl_obj = new_object(OBJ_CYLINDER, (t_shapes){.cy = cl});
-	ft_add_object(&data->object, cl_obj);
+	cl_obj = new_object(&data->arena, OBJ_CYLINDER, (t_shapes){.cy = cl});
+	ft_add_object(&data->object, &data->object_last, cl_obj);
 	return (free_matrix(fields), true);
 }
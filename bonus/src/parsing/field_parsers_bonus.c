@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 09:01:42 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 18:33:27 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -89,12 +89,10 @@ bool	tuple_validator(char **fields, bool b, float min, float max)
 	return (true);
 }
 
+/*
+** ft_split_rt tables are one block, strings included.
+*/
 void	free_matrix(char **matrix)
 {
-	int	i;
-
-	i = 0;
-	while (matrix[i])
-		free(matrix[i++]);
 	free(matrix);
 }
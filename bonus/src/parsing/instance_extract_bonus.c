@@ -0,0 +1,175 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   instance_extract_bonus.c                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 06:39:00 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 21:41:05 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+static t_proto	*find_proto(t_instances *set, char *name)
+{
+	t_proto	*proto;
+
+	proto = set->protos;
+	while (proto && ft_strncmp(proto->name, name, ft_strlen(name) + 1) != 0)
+		proto = proto->next;
+	return (proto);
+}
+
+/*
+** The named prototype, created empty at the end of the list on its first
+** def line.
+*/
+static t_proto	*open_proto(t_instances *set, char *name)
+{
+	t_proto	*proto;
+	t_proto	**tail;
+
+	proto = find_proto(set, name);
+	if (proto)
+		return (proto);
+	proto = ft_calloc(1, sizeof(t_proto));
+	if (!proto)
+		return (NULL);
+	proto->name = ft_strdup(name);
+	if (!proto->name)
+		return (free(proto), NULL);
+	tail = &set->protos;
+	while (*tail)
+		tail = &(*tail)->next;
+	*tail = proto;
+	return (proto);
+}
+
+/*
+** The shape line after the name is parsed as usual, but into the
+** prototype's member list instead of the scene's: list and tail are
+** swapped in for the scene's, so the append stays O(1).
+*/
+static bool	add_member(t_proto *proto, char *shape, t_data *data)
+{
+	t_object	*scene;
+	t_object	*last;
+	bool		ok;
+
+	scene = data->object;
+	last = data->object_last;
+	data->object = proto->members;
+	data->object_last = proto->members_last;
+	ok = object_extract(shape, data);
+	proto->members = data->object;
+	proto->members_last = data->object_last;
+	data->object = scene;
+	data->object_last = last;
+	if (ok && !proto->members_last->bounds.finite)
+		return (printf("❌ def: '%s' members must be bounded (no planes)\n",
+				proto->name), false);
+	return (ok);
+}
+
+/*
+** def <name> <object line>: one more member for the prototype <name>.
+*/
+bool	def_extract(char *line, t_data *data)
+{
+	t_proto	*proto;
+	char	*name;
+	int		i;
+	int		start;
+
+	i = 3;
+	if (line[i] != ' ' && line[i] != '\t')
+		return (printf("❌ def: Invalid identifier\n"), false);
+	skip_spaces(line, &i);
+	start = i;
+	while (line[i] && line[i] != ' ' && line[i] != '\t' && line[i] != '\n')
+		i++;
+	name = ft_substr(line, start, i - start);
+	if (!name)
+		return (printf("❌ def: Failed to read the name\n"), false);
+	skip_spaces(line, &i);
+	if (name[0] == '\0' || line[i] == '\0' || line[i] == '\n')
+		return (printf("❌ def: Expected 'def <name> <object>'\n"),
+			free(name), false);
+	proto = open_proto(&data->instances, name);
+	free(name);
+	if (!proto)
+		return (printf("❌ def: Out of memory\n"), false);
+	if (proto->nodes)
+		return (printf("❌ def: '%s' is already instanced, define it first\n",
+				proto->name), false);
+	return (add_member(proto, line + i, data));
+}
+
+static bool	validate_inst(char **fields, int field_count)
+{
+	if (field_count != 9)
+		return (printf("❌ inst: Expected 9 fields, got %d\n", field_count), false);
+	if (ft_strncmp(fields[0], "inst", 5) != 0)
+		return (printf("❌ inst: Invalid identifier '%s'\n", fields[0]), false);
+	if (!tuple_validator(&fields[2], false, -INFINITY, INFINITY))
+		return (printf("❌ inst: Invalid position (fields 2-4): %s,%s,%s\n", fields[2], fields[3], fields[4]), false);
+	if (!tuple_validator(&fields[5], false, -1.0, 1.0))
+		return (printf("❌ inst: Invalid axis (fields 5-7, range -1 to 1): %s,%s,%s\n", fields[5], fields[6], fields[7]), false);
+	if (ft_atof(fields[5]) == 0 && ft_atof(fields[6]) == 0 && ft_atof(fields[7]) == 0)
+		return (printf("❌ inst: Axis cannot be zero vector (0,0,0)\n"), false);
+	if (!f_field_validation(fields[8]) || !f_range_validator(0.0, INFINITY, fields[8]) || ft_atof(fields[8]) <= 0)
+		return (printf("❌ inst: Invalid scale (field 8, must be > 0): %s\n", fields[8]), false);
+	return (true);
+}
+
+/*
+** The prototype's +Y turned to the axis, scaled uniformly and moved to the
+** position, as for a mesh. The inverse is put together from the same
+** three parts (a rotation inverts by transposing): cheaper than the
+** cofactor inverse when a scene has many inst lines.
+*/
+static void	inst_transform(char **fields, t_matrix *trans, t_matrix *inv)
+{
+	t_matrix	rot;
+	t_tuple		pos;
+	float		scale;
+
+	pos = (t_tuple){ft_atof(fields[2]), ft_atof(fields[3]),
+		ft_atof(fields[4]), 1};
+	rot = align_y_to_vector((t_tuple){ft_atof(fields[5]),
+			ft_atof(fields[6]), ft_atof(fields[7]), 0});
+	scale = ft_atof(fields[8]);
+	*trans = multiply_matrix(translation(pos.x, pos.y, pos.z),
+			multiply_matrix(rot, scaling(scale, scale, scale)));
+	*inv = multiply_matrix(scaling(1.0f / scale, 1.0f / scale, 1.0f / scale),
+			multiply_matrix(transposing_matrix(rot),
+				translation(-pos.x, -pos.y, -pos.z)));
+}
+
+/*
+** inst <name> x,y,z nx,ny,nz scale
+*/
+bool	inst_extract(char *line, t_data *data)
+{
+	t_proto		*proto;
+	t_matrix	trans;
+	t_matrix	inv;
+	char		**fields;
+
+	fields = ft_split_rt(line, " \t,\n");
+	if (!fields)
+		return (printf("❌ inst: Failed to split line\n"), false);
+	if (!validate_inst(fields, count_fields(fields)))
+		return (free_matrix(fields), false);
+	proto = find_proto(&data->instances, fields[1]);
+	if (!proto)
+		return (printf("❌ inst: Unknown prototype '%s'\n", fields[1]),
+			free_matrix(fields), false);
+	inst_transform(fields, &trans, &inv);
+	free_matrix(fields);
+	if (!instance_add(&data->instances, proto, trans, inv))
+		return (printf("❌ inst: Out of memory\n"), false);
+	return (true);
+}
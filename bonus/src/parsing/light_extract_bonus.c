@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 07:16:17 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 18:47:53 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -20,17 +20,36 @@ typedef struct s_parser
 	bool	single_light_set;
 }	t_parser;
 
+/*
+** Optional last field of a light line: range:<r>, the distance at which
+** it has faded out. Without it the light never fades.
+*/
+bool	parse_light_range(char *field, float *range)
+{
+	*range = 0.0f;
+	if (!field)
+		return (true);
+	if (ft_strncmp(field, "range:", 6) != 0 || !f_field_validation(field + 6)
+		|| ft_atof(field + 6) <= 0.0f)
+		return (printf("❌ Error: Expected 'range:<distance > 0>'\n"), false);
+	*range = ft_atof(field + 6);
+	return (true);
+}
+
 bool	extract_light(char *line, t_data *data, t_parser *parser)
 {
 	char	**fields;
 	t_light	*light;
 	t_tuple	position;
 	t_tuple	color;
+	float	range;
 
 	fields = ft_split_rt(line, " \t,\n");
 	if (!fields)
 		return (false);
-	if (!check_fields_num(fields, 8))
+	if (!check_fields_num(fields, 8) && !check_fields_num(fields, 9))
+		return (free_matrix(fields), false);
+	if (!parse_light_range(fields[8], &range))
 		return (free_matrix(fields), false);
 	if (ft_strncmp(fields[0], "L", 2) == 0)
 	{
@@ -53,8 +72,9 @@ bool	extract_light(char *line, t_data *data, t_parser *parser)
 		ft_atof(fields[3]), 1};
 	color = (t_tuple){ft_atoi(fields[5]) / 255.0, ft_atoi(fields[6]) / 255.0, \
 		ft_atoi(fields[7]) / 255.0, 0};
-	light = new_light(position, color);
+	light = new_light(&data->light_arena, position, color);
 	light->brightness = ft_atof(fields[4]);
-	ft_add_light(&data->light, light);
+	light->range = range;
+	ft_add_light(&data->light, &data->light_last, light);
 	return (free_matrix(fields), true);
 }
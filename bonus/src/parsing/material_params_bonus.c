@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/08 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2025/12/28 16:01:41 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 00:09:18 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -160,6 +160,19 @@ static bool	parse_refraction(char *param, float *transparency, float *refract_in
 	return (free_matrix(parts), valid);
 }
 
+static bool	parse_shadow_flag(char *param, char *key, bool *flag)
+{
+	size_t	len;
+
+	len = ft_strlen(key);
+	if (ft_strncmp(param, key, len) != 0)
+		return (false);
+	if ((param[len] != '0' && param[len] != '1') || param[len + 1])
+		return (false);
+	*flag = (param[len] == '1');
+	return (true);
+}
+
 static bool	parse_shininess(char *param, float *specular, float *shininess)
 {
 	char	**parts;
@@ -191,7 +204,7 @@ static bool	parse_shininess(char *param, float *specular, float *shininess)
 }
 
 bool	parse_material_params(char **fields, int start_idx, t_material *mat, 
-			mlx_t *mlx)
+			t_tex_cache *textures)
 {
 	int		i;
 	bool    saw_pattern;
@@ -231,6 +244,10 @@ bool	parse_material_params(char **fields, int start_idx, t_material *mat,
 				mat->specular = specular;
 			mat->shininess = shininess;
 		}
+		else if (parse_shadow_flag(fields[i], "cast:", &mat->casts_shadow))
+			;
+		else if (parse_shadow_flag(fields[i], "recv:", &mat->receives_shadow))
+			;
 		else if (ft_strncmp(fields[i], "bump:", 5) == 0 || 
 				ft_strncmp(fields[i], "bump_strength:", 14) == 0 ||
 				ft_strncmp(fields[i], "normal:", 7) == 0 ||
@@ -246,7 +263,7 @@ bool	parse_material_params(char **fields, int start_idx, t_material *mat,
 	}
 	if (saw_pattern && mat->pattern.at == NULL)
 		mat->pattern = stripe_patern(mat->pattern.a, mat->pattern.b);
-	if (!load_material_textures(mat, &fields[start_idx], mlx))
+	if (!load_material_textures(mat, &fields[start_idx], textures))
 		return (false);
 	return (true);
 }
@@ -0,0 +1,105 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mesh_extract_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 04:21:53 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 18:55:06 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+#include "../../includes/texture_bonus.h"
+
+/*
+** The OBJ's own +Y is turned to the axis, then it is scaled uniformly and
+** moved to the position.
+*/
+static void	setup_mesh_data(t_mesh *me, char **fields)
+{
+	t_tuple	axis;
+	float	scale;
+
+	axis = (t_tuple){ft_atof(fields[5]), ft_atof(fields[6]),
+		ft_atof(fields[7]), 0};
+	scale = ft_atof(fields[8]);
+	me->trans = multiply_matrix(translation(ft_atof(fields[2]),
+				ft_atof(fields[3]), ft_atof(fields[4])),
+			multiply_matrix(align_y_to_vector(axis),
+				scaling(scale, scale, scale)));
+	me->trans_inv = inverse_matrix(me->trans);
+	me->material.color.x = ft_atoi(fields[9]) / 255.0;
+	me->material.color.y = ft_atoi(fields[10]) / 255.0;
+	me->material.color.z = ft_atoi(fields[11]) / 255.0;
+	me->material.color.w = 0;
+}
+
+static bool	validate_mesh(char **fields, int field_count)
+{
+	if (field_count < 12)
+		return (printf("❌ mesh: Expected at least 12 fields, got %d\n", field_count), false);
+	if (ft_strncmp(fields[0], "mesh", 5) != 0)
+		return (printf("❌ mesh: Invalid identifier '%s'\n", fields[0]), false);
+	if (ft_strlen(fields[1]) < 5 || ft_strncmp(fields[1] + ft_strlen(fields[1]) - 4, ".obj", 5) != 0)
+		return (printf("❌ mesh: Expected an .obj file (field 1): %s\n", fields[1]), false);
+	if (!tuple_validator(&fields[2], false, -INFINITY, INFINITY))
+		return (printf("❌ mesh: Invalid position (fields 2-4): %s,%s,%s\n", fields[2], fields[3], fields[4]), false);
+	if (!tuple_validator(&fields[5], false, -1.0, 1.0))
+		return (printf("❌ mesh: Invalid axis (fields 5-7, range -1 to 1): %s,%s,%s\n", fields[5], fields[6], fields[7]), false);
+	if (ft_atof(fields[5]) == 0 && ft_atof(fields[6]) == 0 && ft_atof(fields[7]) == 0)
+		return (printf("❌ mesh: Axis cannot be zero vector (0,0,0)\n"), false);
+	if (!f_field_validation(fields[8]) || !f_range_validator(0.0, INFINITY, fields[8]) || ft_atof(fields[8]) <= 0)
+		return (printf("❌ mesh: Invalid scale (field 8, must be > 0): %s\n", fields[8]), false);
+	if (!tuple_validator(&fields[9], true, 0, 255))
+		return (printf("❌ mesh: Invalid color (fields 9-11, range 0-255): %s,%s,%s\n", fields[9], fields[10], fields[11]), false);
+	return (true);
+}
+
+/*
+** Bump and normal maps derive their tangent frame from the analytic UV
+** mappings, which a mesh does not have; colour textures use the OBJ UVs.
+*/
+static bool	mesh_material(char **fields, int field_count, t_mesh *me,
+	t_data *data)
+{
+	if (field_count > 12
+		&& !parse_material_params(fields, 12, &me->material, data->textures))
+		return (printf("❌ mesh: Invalid material params\n"), false);
+	if (me->material.has_bump_map || me->material.has_normal_map)
+	{
+		free_material_textures(&me->material, data->textures);
+		return (printf("❌ mesh: bump and normal maps are not supported on meshes\n"), false);
+	}
+	return (true);
+}
+
+bool	mesh_extract(char *line, t_data *data)
+{
+	t_mesh		me;
+	t_object	*me_obj;
+	char		**fields;
+	int			field_count;
+
+	fields = ft_split_rt(line, " \t,\n");
+	if (!fields)
+		return (printf("❌ mesh: Failed to split line\n"), false);
+	field_count = count_fields(fields);
+	if (!validate_mesh(fields, field_count))
+		return (free_matrix(fields), false);
+	ft_bzero(&me, sizeof(me));
+	me.material = material();
+	setup_mesh_data(&me, fields);
+	if (!mesh_material(fields, field_count, &me, data))
+		return (free_matrix(fields), false);
+	me.geo = mesh_load(fields[1]);
+	if (!me.geo)
+		return (free_material_textures(&me.material, data->textures),
+			free_matrix(fields), false);
+	printf("✅ Mesh %s: %d triangles, %d BVH nodes\n", me.geo->path,
+		me.geo->tri_count, me.geo->node_count);
+	me_obj = new_object(&data->arena, OBJ_MESH, (t_shapes){.me = me});
+	ft_add_object(&data->object, &data->object_last, me_obj);
+	return (free_matrix(fields), true);
+}
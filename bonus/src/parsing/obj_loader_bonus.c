@@ -0,0 +1,294 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   obj_loader_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 03:53:01 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 03:53:01 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+#include <sys/stat.h>
+
+typedef struct s_obj_reader
+{
+	t_mesh_data	*m;
+	int			pos_cap;
+	int			nrm_cap;
+	int			uv_cap;
+	int			tri_cap;
+	int			line;
+}	t_obj_reader;
+
+static bool	reserve(void **array, int *cap, int need, size_t size)
+{
+	void	*grown;
+	int		new_cap;
+
+	if (need <= *cap)
+		return (true);
+	new_cap = *cap * 2;
+	if (new_cap < 1024)
+		new_cap = 1024;
+	while (new_cap < need)
+		new_cap *= 2;
+	grown = realloc(*array, (size_t)new_cap * size);
+	if (!grown)
+		return (false);
+	*array = grown;
+	*cap = new_cap;
+	return (true);
+}
+
+/*
+** Reads up to n floats after a v, vn or vt keyword; at least min of them
+** must be there.
+*/
+static char	*read_floats(char *p, float *out, int n, int min)
+{
+	char	*end;
+	int		i;
+
+	i = 0;
+	while (i < n)
+	{
+		out[i] = strtof(p, &end);
+		if (end == p)
+			break ;
+		p = end;
+		i++;
+	}
+	if (i < min)
+		return (NULL);
+	while (i < n)
+		out[i++] = 0.0f;
+	return (p);
+}
+
+static bool	read_vertex(t_obj_reader *r, char *p)
+{
+	t_mesh_data	*m;
+
+	m = r->m;
+	if (p[1] == ' ' || p[1] == '\t')
+	{
+		if (!reserve((void **)&m->pos, &r->pos_cap, m->pos_count + 1,
+				3 * sizeof(float)))
+			return (false);
+		return (read_floats(p + 1, &m->pos[3 * m->pos_count++], 3, 3) != NULL);
+	}
+	if (p[1] == 'n')
+	{
+		if (!reserve((void **)&m->nrm, &r->nrm_cap, m->nrm_count + 1,
+				3 * sizeof(float)))
+			return (false);
+		return (read_floats(p + 2, &m->nrm[3 * m->nrm_count++], 3, 3) != NULL);
+	}
+	if (p[1] == 't')
+	{
+		if (!reserve((void **)&m->uv, &r->uv_cap, m->uv_count + 1,
+				2 * sizeof(float)))
+			return (false);
+		return (read_floats(p + 2, &m->uv[2 * m->uv_count++], 2, 1) != NULL);
+	}
+	return (true);
+}
+
+/*
+** One face index: 1-based, or negative to count back from the last
+** element read so far. Stored 0-based, -1 when absent.
+*/
+static bool	resolve_index(char **p, int count, int *out)
+{
+	char	*end;
+	long	idx;
+
+	idx = strtol(*p, &end, 10);
+	if (end == *p)
+		return (false);
+	*p = end;
+	if (idx < 0)
+		idx += count + 1;
+	if (idx < 1 || idx > count)
+		return (false);
+	*out = (int)idx - 1;
+	return (true);
+}
+
+/*
+** v, v/t, v//n or v/t/n. Returns false on a malformed corner or an index
+** outside the arrays read so far.
+*/
+static bool	read_corner(t_obj_reader *r, char **p, int corner[3])
+{
+	corner[1] = -1;
+	corner[2] = -1;
+	if (!resolve_index(p, r->m->pos_count, &corner[0]))
+		return (false);
+	if (**p != '/')
+		return (true);
+	(*p)++;
+	if (**p != '/' && !resolve_index(p, r->m->uv_count, &corner[1]))
+		return (false);
+	if (**p != '/')
+		return (true);
+	(*p)++;
+	return (resolve_index(p, r->m->nrm_count, &corner[2]));
+}
+
+static bool	add_triangle(t_obj_reader *r, int a[3], int b[3], int c[3])
+{
+	t_mesh_tri	*tri;
+
+	if (!reserve((void **)&r->m->tris, &r->tri_cap, r->m->tri_count + 1,
+			sizeof(t_mesh_tri)))
+		return (false);
+	tri = &r->m->tris[r->m->tri_count++];
+	tri->v[0] = a[0];
+	tri->v[1] = b[0];
+	tri->v[2] = c[0];
+	tri->t[0] = a[1];
+	tri->t[1] = b[1];
+	tri->t[2] = c[1];
+	tri->n[0] = a[2];
+	tri->n[1] = b[2];
+	tri->n[2] = c[2];
+	if (a[2] < 0 || b[2] < 0 || c[2] < 0)
+		tri->n[0] = -1;
+	if (a[1] < 0 || b[1] < 0 || c[1] < 0)
+		tri->t[0] = -1;
+	return (true);
+}
+
+/*
+** Polygons are split into a fan around their first corner. A triangle
+** missing any corner's normal or UV is marked with n[0] or t[0] = -1.
+*/
+static bool	read_face(t_obj_reader *r, char *p)
+{
+	int	first[3];
+	int	prev[3];
+	int	cur[3];
+	int	corners;
+
+	corners = 0;
+	while (1)
+	{
+		while (*p == ' ' || *p == '\t')
+			p++;
+		if (*p == '\0' || *p == '\n' || *p == '\r' || *p == '#')
+			break ;
+		if (!read_corner(r, &p, cur))
+			return (false);
+		if (corners == 0)
+			ft_memcpy(first, cur, sizeof(first));
+		else if (corners >= 2 && !add_triangle(r, first, prev, cur))
+			return (false);
+		ft_memcpy(prev, cur, sizeof(prev));
+		corners++;
+	}
+	return (corners >= 3);
+}
+
+static bool	read_line(t_obj_reader *r, char *p)
+{
+	while (*p == ' ' || *p == '\t')
+		p++;
+	if (p[0] == 'v')
+		return (read_vertex(r, p));
+	if (p[0] == 'f' && (p[1] == ' ' || p[1] == '\t'))
+		return (read_face(r, p + 1));
+	return (true);
+}
+
+/*
+** The whole file in one buffer, NUL-terminated; lines are read in place.
+*/
+static char	*read_file(char *path, t_mesh_data *m)
+{
+	struct stat	st;
+	char		*buf;
+	ssize_t		got;
+	size_t		len;
+	int			fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return (NULL);
+	if (fstat(fd, &st) != 0)
+		return (close(fd), NULL);
+	m->mtime = st.st_mtim;
+	buf = malloc(st.st_size + 1);
+	len = 0;
+	got = 1;
+	while (buf && got > 0 && len < (size_t)st.st_size)
+	{
+		got = read(fd, buf + len, st.st_size - len);
+		if (got > 0)
+			len += got;
+	}
+	close(fd);
+	if (buf && got < 0)
+		return (free(buf), NULL);
+	if (buf)
+		buf[len] = '\0';
+	return (buf);
+}
+
+static bool	read_obj(t_obj_reader *r, char *buf)
+{
+	char	*p;
+	char	*eol;
+
+	p = buf;
+	while (*p)
+	{
+		r->line++;
+		eol = ft_strchr(p, '\n');
+		if (eol)
+			*eol = '\0';
+		if (!read_line(r, p))
+			return (false);
+		if (!eol)
+			break ;
+		p = eol + 1;
+	}
+	return (true);
+}
+
+/*
+** Positions, normals, UVs and (triangulated) faces of an .obj file, with
+** the BVH built. Materials, groups and everything else are ignored.
+*/
+t_mesh_data	*mesh_load(char *path)
+{
+	t_obj_reader	r;
+	char			*buf;
+	uint64_t		start;
+
+	start = prof_now();
+	ft_bzero(&r, sizeof(r));
+	r.m = ft_calloc(1, sizeof(t_mesh_data));
+	if (!r.m)
+		return (NULL);
+	r.m->path = ft_strdup(path);
+	buf = read_file(path, r.m);
+	if (!r.m->path || !buf)
+		return (printf("❌ mesh: Cannot read '%s'\n", path), free(buf),
+			mesh_free(r.m), NULL);
+	if (!read_obj(&r, buf))
+		return (printf("❌ mesh: %s:%d: Invalid or unsupported line\n", path,
+				r.line), free(buf), mesh_free(r.m), NULL);
+	free(buf);
+	prof_span("obj_load", start, r.m->tri_count);
+	if (r.m->tri_count == 0)
+		return (printf("❌ mesh: '%s' has no faces\n", path),
+			mesh_free(r.m), NULL);
+	if (!mesh_build_bvh(r.m))
+		return (printf("❌ mesh: Out of memory building the BVH of '%s'\n",
+				path), mesh_free(r.m), NULL);
+	return (r.m);
+}
@@ -0,0 +1,308 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_bonus.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 09:14:26 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 22:24:23 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+static void	default_options(t_options *opts)
+{
+	opts->scene = NULL;
+	opts->job.trace.min_weight = MIN_RAY_WEIGHT;
+	opts->job.trace.russian_roulette = false;
+	opts->job.trace.light_cutoff = 0.0f;
+	opts->job.trace.light_samples = 0;
+	opts->job.width = 1920;
+	opts->job.height = 1080;
+	opts->job.samples = 1;
+	opts->job.region = (t_tile){0, 0, 0, 0};
+	opts->job.has_camera = false;
+	opts->output = NULL;
+	opts->listen = NULL;
+	opts->worker = NULL;
+	opts->serve = NULL;
+	opts->connect = NULL;
+	opts->workers = 0;
+	opts->tile_timeout = TILE_TIMEOUT;
+	opts->checkpoint = NULL;
+	opts->checkpoint_every = CHECKPOINT_INTERVAL;
+	opts->resume = false;
+	opts->gbuffer = false;
+	opts->heatmap = HEAT_COLOR;
+	opts->frames = 0;
+	opts->fps = DEFAULT_FPS;
+}
+
+static bool	parse_weight(char *arg, char *flag, float *out)
+{
+	if (!arg || !f_field_validation(arg))
+		return (printf("❌ %s: expected a number\n", flag), false);
+	*out = ft_atof(arg);
+	if (*out < 0.0f || *out > 1.0f)
+		return (printf("❌ %s: must be in [0, 1]\n", flag), false);
+	return (true);
+}
+
+static bool	parse_seconds(char *arg, char *flag, float *out)
+{
+	if (!arg || !f_field_validation(arg) || ft_atof(arg) <= 0.0f)
+		return (printf("❌ %s: expected seconds > 0\n", flag), false);
+	*out = ft_atof(arg);
+	return (true);
+}
+
+static bool	parse_fps(char *arg, float *out)
+{
+	if (!arg || !f_field_validation(arg) || ft_atof(arg) <= 0.0f)
+		return (printf("❌ --fps: expected frames per second > 0\n"), false);
+	*out = ft_atof(arg);
+	return (true);
+}
+
+static bool	parse_count(char *arg, char *flag, int max, int *out)
+{
+	int	i;
+
+	i = 0;
+	while (arg && ft_isdigit(arg[i]))
+		i++;
+	if (!arg || i == 0 || arg[i] || i > 9 || ft_atoi(arg) > max)
+		return (printf("❌ %s: expected an integer in [0, %d]\n", flag, max),
+			false);
+	*out = ft_atoi(arg);
+	return (true);
+}
+
+static bool	parse_size(char *arg, t_options *opts)
+{
+	char	*x;
+	bool	ok;
+
+	x = NULL;
+	if (arg)
+		x = ft_strchr(arg, 'x');
+	if (!x)
+		return (printf("❌ --size: expected <width>x<height>\n"), false);
+	*x = '\0';
+	ok = parse_count(arg, "--size", 16384, &opts->job.width)
+		&& parse_count(x + 1, "--size", 16384, &opts->job.height);
+	*x = 'x';
+	if (ok && (opts->job.width == 0 || opts->job.height == 0))
+		return (printf("❌ --size: dimensions must be positive\n"), false);
+	return (ok);
+}
+
+/*
+** Same seven numbers as a scene's C line: position, orientation, fov.
+*/
+static bool	parse_camera(char *arg, t_job *job)
+{
+	char	**f;
+
+	f = NULL;
+	if (arg)
+		f = ft_split_rt(arg, ",");
+	if (!f || !check_fields_num(f, 7)
+		|| !tuple_validator(&f[0], false, -INFINITY, INFINITY)
+		|| !tuple_validator(&f[3], false, -1, 1)
+		|| !i_field_validation(f[6]) || !i_range_validator(0, 180, f[6]))
+	{
+		if (f)
+			free_matrix(f);
+		return (printf("❌ --camera: expected x,y,z,dx,dy,dz,fov\n"), false);
+	}
+	job->eye = (t_tuple){ft_atof(f[0]), ft_atof(f[1]), ft_atof(f[2]), 1};
+	job->dir = (t_tuple){ft_atof(f[3]), ft_atof(f[4]), ft_atof(f[5]), 0};
+	job->fov = ft_atoi(f[6]);
+	job->has_camera = true;
+	return (free_matrix(f), true);
+}
+
+/*
+** x,y,w,h in pixels. Checked against --size once every flag is read.
+*/
+static bool	parse_region(char *arg, t_job *job)
+{
+	char	**f;
+	bool	ok;
+
+	f = NULL;
+	if (arg)
+		f = ft_split_rt(arg, ",");
+	if (!f || !check_fields_num(f, 4))
+	{
+		if (f)
+			free_matrix(f);
+		return (printf("❌ --region: expected x,y,w,h\n"), false);
+	}
+	ok = parse_count(f[0], "--region", 16384, &job->region.x)
+		&& parse_count(f[1], "--region", 16384, &job->region.y)
+		&& parse_count(f[2], "--region", 16384, &job->region.w)
+		&& parse_count(f[3], "--region", 16384, &job->region.h);
+	free_matrix(f);
+	if (!ok)
+		return (false);
+	if (job->region.w == 0 || job->region.h == 0)
+		return (printf("❌ --region: width and height must be positive\n"),
+			false);
+	return (true);
+}
+
+static bool	parse_heatmap(char *arg, t_heat *out)
+{
+	t_heat	m;
+
+	m = HEAT_TIME;
+	while (arg && m < HEAT_VIEWS)
+	{
+		if (ft_strncmp(arg, heat_name(m), ft_strlen(heat_name(m)) + 1) == 0)
+			return (*out = m, true);
+		m++;
+	}
+	return (printf("❌ --heatmap: expected time, tests, shadows or depth\n"),
+		false);
+}
+
+static bool	parse_flag(char **argv, int *i, t_options *opts)
+{
+	if (ft_strncmp(argv[*i], "--rr", 5) == 0)
+		return (opts->job.trace.russian_roulette = true, true);
+	if (ft_strncmp(argv[*i], "--min-weight", 13) == 0)
+		return (parse_weight(argv[++(*i)], "--min-weight",
+				&opts->job.trace.min_weight));
+	if (ft_strncmp(argv[*i], "--light-cutoff", 15) == 0)
+		return (parse_weight(argv[++(*i)], "--light-cutoff",
+				&opts->job.trace.light_cutoff));
+	if (ft_strncmp(argv[*i], "--light-samples", 16) == 0)
+		return (parse_count(argv[++(*i)], "--light-samples",
+				MAX_LIGHT_SAMPLES, &opts->job.trace.light_samples));
+	if (ft_strncmp(argv[*i], "--size", 7) == 0)
+		return (parse_size(argv[++(*i)], opts));
+	if (ft_strncmp(argv[*i], "--samples", 10) == 0)
+	{
+		if (!parse_count(argv[++(*i)], "--samples", MAX_SAMPLES,
+				&opts->job.samples))
+			return (false);
+		if (opts->job.samples == 0)
+			return (printf("❌ --samples: must be at least 1\n"), false);
+		return (true);
+	}
+	if (ft_strncmp(argv[*i], "--camera", 9) == 0)
+		return (parse_camera(argv[++(*i)], &opts->job));
+	if (ft_strncmp(argv[*i], "--region", 9) == 0)
+		return (parse_region(argv[++(*i)], &opts->job));
+	if (ft_strncmp(argv[*i], "--workers", 10) == 0)
+		return (parse_count(argv[++(*i)], "--workers", MAX_WORKERS,
+				&opts->workers));
+	if (ft_strncmp(argv[*i], "--tile-timeout", 15) == 0)
+		return (parse_seconds(argv[++(*i)], "--tile-timeout",
+				&opts->tile_timeout));
+	if (ft_strncmp(argv[*i], "--checkpoint-every", 19) == 0)
+		return (parse_seconds(argv[++(*i)], "--checkpoint-every",
+				&opts->checkpoint_every));
+	if (ft_strncmp(argv[*i], "--checkpoint", 13) == 0)
+		return (opts->checkpoint = argv[++(*i)], opts->checkpoint != NULL);
+	if (ft_strncmp(argv[*i], "--resume", 9) == 0)
+		return (opts->resume = true, true);
+	if (ft_strncmp(argv[*i], "--gbuffer", 10) == 0)
+		return (opts->gbuffer = true, true);
+	if (ft_strncmp(argv[*i], "--heatmap", 10) == 0)
+		return (parse_heatmap(argv[++(*i)], &opts->heatmap));
+	if (ft_strncmp(argv[*i], "--frames", 9) == 0)
+		return (parse_count(argv[++(*i)], "--frames", MAX_FRAMES,
+				&opts->frames));
+	if (ft_strncmp(argv[*i], "--fps", 6) == 0)
+		return (parse_fps(argv[++(*i)], &opts->fps));
+	if (ft_strncmp(argv[*i], "--output", 9) == 0)
+		return (opts->output = argv[++(*i)], opts->output != NULL);
+	if (ft_strncmp(argv[*i], "--listen", 9) == 0)
+		return (opts->listen = argv[++(*i)], opts->listen != NULL);
+	if (ft_strncmp(argv[*i], "--worker", 9) == 0)
+		return (opts->worker = argv[++(*i)], opts->worker != NULL);
+	if (ft_strncmp(argv[*i], "--serve", 8) == 0)
+		return (opts->serve = argv[++(*i)], opts->serve != NULL);
+	if (ft_strncmp(argv[*i], "--connect", 10) == 0)
+		return (opts->connect = argv[++(*i)], opts->connect != NULL);
+	return (printf("❌ Unknown argument '%s'\n", argv[*i]), false);
+}
+
+/*
+** Command line: <scene.rt> followed by optional flags.
+**   --rr               unbiased Russian roulette instead of the hard cutoff
+**   --min-weight <w>   throughput below which secondary rays are dropped
+**                      (0 traces every ray down to MAX_REFLECTION_DEPTH)
+**   --light-cutoff <c> skip a light where it adds less than c (0)
+**   --light-samples <n>  shade n lights per hit, picked at random in
+**                      proportion to their contribution (0: all of them)
+**   --size <w>x<h>     render resolution (1920x1080)
+**   --samples <n>      rays averaged per pixel (1)
+**   --camera <x,y,z,dx,dy,dz,fov>  replaces the scene's camera
+**   --region <x,y,w,h> trace only this rectangle of the frame
+**   --workers <n>      headless: split the frame across n local processes
+**   --listen <addr>    headless: also accept remote workers on addr
+**   --output <file>    where a headless render is written (.ppm or .pfm)
+**   --frames <n>       headless: render n frames of the scene's animation
+**                      to <output stem>_0000<ext>, ... (frame.ppm)
+**   --fps <f>          frames per second of animation time (24)
+**   --tile-timeout <s> reassign a tile a worker has not returned in time
+**   --checkpoint <f>   save finished tiles to f while rendering (also
+**                      with --workers/--listen; not with --connect)
+**   --checkpoint-every <s>  seconds between saves (60)
+**   --resume           start from the tiles already in --checkpoint
+**   --gbuffer          keep first hits so R can relight without retracing
+**   --heatmap <metric> record per-pixel cost and show time, tests, shadows
+**                      or depth as a false-colour map (window only)
+**   --worker <addr>    run as a worker for the coordinator at addr (no scene)
+**   --serve <addr>     run as a render server on addr (no scene)
+**   --connect <addr>   have the render server at addr trace the scene
+** An addr is host:port for TCP, anything else is a Unix socket path.
+*/
+bool	parse_options(int argc, char **argv, t_options *opts)
+{
+	int		i;
+	t_tile	region;
+
+	default_options(opts);
+	i = 1;
+	while (i < argc)
+	{
+		if (argv[i][0] == '-')
+		{
+			if (!parse_flag(argv, &i, opts))
+				return (false);
+		}
+		else if (opts->scene)
+			return (printf("❌ Unknown argument '%s'\n", argv[i]), false);
+		else
+			opts->scene = argv[i];
+		i++;
+	}
+	if (opts->worker || opts->serve)
+		return (opts->scene == NULL);
+	if (opts->resume && !opts->checkpoint)
+		return (printf("❌ --resume needs --checkpoint <file>\n"), false);
+	if (opts->gbuffer && (opts->job.samples > 1 || opts->resume))
+		return (printf("❌ --gbuffer: needs --samples 1 and no --resume\n"),
+			false);
+	if (opts->checkpoint && opts->connect)
+		return (printf("❌ --checkpoint: not with --connect, the server "
+				"renders that job\n"), false);
+	if (opts->heatmap && (opts->workers > 0 || opts->listen || opts->connect
+			|| opts->frames))
+		return (printf("❌ --heatmap: only for the window renderer\n"), false);
+	if (opts->frames && (opts->workers > 0 || opts->listen || opts->connect
+			|| opts->checkpoint || opts->gbuffer))
+		return (printf("❌ --frames: renders locally, without --workers, "
+				"--listen, --connect, --checkpoint or --gbuffer\n"), false);
+	if (!job_region(&opts->job, &region))
+		return (printf("❌ --region: does not fit in %dx%d\n",
+				opts->job.width, opts->job.height), false);
+	return (opts->scene != NULL);
+}
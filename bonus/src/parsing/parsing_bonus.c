@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/01 00:00:00 by amn700            #+#    #+#             */
-/*   Updated: 2025/12/02 21:05:44 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 08:48:54 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -56,13 +56,23 @@ bool	check_extension(char *file)
 
 bool	complete_parsing(char *file, t_data *data)
 {
+	uint64_t	start;
+	bool		ok;
+
 	if (!check_extension(file))
 		return (errors_map(1), false);
-	if (!extract_data(file, data))
-		return (false);
-	apply_ambient_to_objects(data);
+	start = prof_now();
+	ok = extract_data(file, data);
+	if (ok && !instances_build(&data->instances))
+	{
+		free_objects_and_lights(data);
+		ok = false;
+	}
+	if (ok)
+		apply_ambient_to_objects(data);
 	// check_parsed_data(data);
-	return (true);
+	prof_span("complete_parsing", start, -1);
+	return (ok);
 }
 
 // int main(int argc, char **argv)
@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 09:01:42 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 19:02:19 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -63,9 +63,9 @@ bool	plane_extract(char *line, t_data *data)
 	pl = plane();
 	pl.material = material();
 	setup_plane_data(&pl, fields);
-	if (field_count > 10 && !parse_material_params(fields, 10, &pl.material, data->ptr))
+	if (field_count > 10 && !parse_material_params(fields, 10, &pl.material, data->textures))
 		return (printf("❌ pl: Invalid material params starting at field 10\n"), free_matrix(fields), false);
-	pl_obj = new_object(OBJ_PLANE, (t_shapes){.pl = pl});
-	ft_add_object(&data->object, pl_obj);
+	pl_obj = new_object(&data->arena, OBJ_PLANE, (t_shapes){.pl = pl});
+	ft_add_object(&data->object, &data->object_last, pl_obj);
 	return (free_matrix(fields), true);
 }
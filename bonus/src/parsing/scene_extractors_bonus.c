@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 07:16:17 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 14:06:26 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -23,10 +23,50 @@ typedef struct s_parser
 bool	extract_ambient_light(char *line, t_data *data, t_parser *parser);
 bool	extract_camera(char *line, t_data *data, t_parser *parser);
 bool	extract_light(char *line, t_data *data, t_parser *parser);
+bool	extract_area_light(char *line, t_data *data, t_parser *parser);
 bool	sphere_extract(char *line, t_data *data);
 bool	plane_extract(char *line, t_data *data);
 bool	cylinder_extract(char *line, t_data *data);
 bool	cone_extract(char *line, t_data *data);
+bool	mesh_extract(char *line, t_data *data);
+bool	def_extract(char *line, t_data *data);
+bool	inst_extract(char *line, t_data *data);
+bool	anim_extract(char *line, t_data *data);
+
+/*
+** A shape line, added to data->object (def points that at a prototype).
+*/
+bool	object_extract(char *line, t_data *data)
+{
+	if (ft_strncmp(line, "sp", 2) == 0)
+		return (sphere_extract(line, data));
+	else if (ft_strncmp(line, "pl", 2) == 0)
+		return (plane_extract(line, data));
+	else if (ft_strncmp(line, "cy", 2) == 0)
+		return (cylinder_extract(line, data));
+	else if (ft_strncmp(line, "co", 2) == 0)
+		return (cone_extract(line, data));
+	else if (ft_strncmp(line, "mesh", 4) == 0)
+		return (mesh_extract(line, data));
+	printf("Error: Unrecognized line format - expected A, C, L, rl, sl, sp, pl, cy, co, mesh, def, inst, or anim\n");
+	return (false);
+}
+
+/*
+** What a scene line defines, for the anim lines that may follow it.
+*/
+static t_anim_kind	line_kind(char *line)
+{
+	if (line[0] == 'C')
+		return (ANIM_CAMERA);
+	if (line[0] == 'L' || line[0] == 'l' || ft_strncmp(line, "rl", 2) == 0
+		|| ft_strncmp(line, "sl", 2) == 0)
+		return (ANIM_LIGHT);
+	if (line[0] == 'A' || ft_strncmp(line, "def", 3) == 0
+		|| ft_strncmp(line, "inst", 4) == 0)
+		return (ANIM_NONE);
+	return (ANIM_OBJECT);
+}
 
 static bool	extractor(char *line, t_data *data, t_parser *parser)
 {
@@ -36,26 +76,23 @@ static bool	extractor(char *line, t_data *data, t_parser *parser)
 	skip_spaces(line, &i);
 	if (line[i] == '\0' || line[i] == '#')
 		return (true);
+	if (ft_strncmp(line + i, "anim", 4) == 0)
+		return (anim_extract(line + i, data));
+	data->anim.last = line_kind(line + i);
 	if (line[i] == 'A')
 		return (extract_ambient_light(line + i, data, parser));
 	else if (line[i] == 'C')
 		return (extract_camera(line + i, data, parser));
 	else if (line[i] == 'L' || line[i] == 'l')
 		return (extract_light(line + i, data, parser));
-	else if (ft_strncmp(line + i, "sp", 2) == 0)
-		return (sphere_extract(line + i, data));
-	else if (ft_strncmp(line + i, "pl", 2) == 0)
-		return (plane_extract(line + i, data));
-	else if (ft_strncmp(line + i, "cy", 2) == 0)
-		return (cylinder_extract(line + i, data));
-	else if (ft_strncmp(line + i, "co", 2) == 0)
-		return (cone_extract(line + i, data));
-	else
-	{
-		printf("Error: Unrecognized line format - expected A, C, L, sp, pl, cy, or co\n");
-		return (false);
-	}
-	return (true);
+	else if (ft_strncmp(line + i, "rl", 2) == 0
+		|| ft_strncmp(line + i, "sl", 2) == 0)
+		return (extract_area_light(line + i, data, parser));
+	else if (ft_strncmp(line + i, "def", 3) == 0)
+		return (def_extract(line + i, data));
+	else if (ft_strncmp(line + i, "inst", 4) == 0)
+		return (inst_extract(line + i, data));
+	return (object_extract(line + i, data));
 }
 
 bool	extract_data(char *file, t_data *data)
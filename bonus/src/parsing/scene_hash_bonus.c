@@ -0,0 +1,49 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   scene_hash_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 17:46:49 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 17:46:49 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+uint64_t	hash_bytes(uint64_t hash, const void *data, size_t size)
+{
+	const unsigned char	*bytes;
+	size_t				i;
+
+	bytes = data;
+	i = 0;
+	while (i < size)
+		hash = (hash ^ bytes[i++]) * FNV_PRIME;
+	return (hash);
+}
+
+/*
+** FNV-1a over the file's bytes: an edited scene hashes differently even
+** when its path and mtime do not change.
+*/
+bool	scene_hash(char *path, uint64_t *hash)
+{
+	unsigned char	buf[65536];
+	ssize_t			got;
+	int				fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return (false);
+	*hash = FNV_OFFSET;
+	got = read(fd, buf, sizeof(buf));
+	while (got > 0)
+	{
+		*hash = hash_bytes(*hash, buf, got);
+		got = read(fd, buf, sizeof(buf));
+	}
+	close(fd);
+	return (got == 0);
+}
@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 07:16:17 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 19:09:32 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -61,9 +61,9 @@ bool	sphere_extract(char *line, t_data *data)
 	sp = sphere();
 	sp.material = material();
 	setup_sphere_transform(&sp, fields);
-	if (field_count > 8 && !parse_material_params(fields, 8, &sp.material, data->ptr))
+	if (field_count > 8 && !parse_material_params(fields, 8, &sp.material, data->textures))
 		return (printf("❌ sp: Invalid material params starting at field 8\n"), free_matrix(fields), false);
-	sp_obj = new_object(OBJ_SPHERE, (t_shapes){.sp = sp});
-	ft_add_object(&data->object, sp_obj);
+	sp_obj = new_object(&data->arena, OBJ_SPHERE, (t_shapes){.sp = sp});
+	ft_add_object(&data->object, &data->object_last, sp_obj);
 	return (free_matrix(fields), true);
 }
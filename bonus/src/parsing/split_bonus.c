@@ -14,13 +14,6 @@ static char	*ft_strchr_local(const char *s, int c)
 	return (NULL);
 }
 
-static void	free_split_matrix(char **matrix, int i)
-{
-	while (i >= 0)
-		free(matrix[i--]);
-	free(matrix);
-}
-
 static int	count_words(char *str, char *charset)
 {
 	int	i;
@@ -40,66 +33,45 @@ static int	count_words(char *str, char *charset)
 	return (count);
 }
 
-static char	*ft_addstr(char *str, char *charset)
-{
-	int		i;
-	int		size;
-	char	*new;
-
-	size = 0;
-	while (!ft_strchr_local(charset, str[size]) && str[size])
-		size++;
-	new = malloc(size + 1);
-	if (new == NULL)
-		return (NULL);
-	i = 0;
-	while (i < size)
-	{
-		new[i] = str[i];
-		i++;
-	}
-	new[size] = '\0';
-	return (new);
-}
-
-static int	populate(char **matrix, char *str, char *charset)
+/*
+** Cuts the copy in place: each delimiter becomes a terminator and each
+** word start goes into the table.
+*/
+static void	populate(char **matrix, char *str, char *charset)
 {
 	int	i;
 
 	i = 0;
 	while (*str)
 	{
-		while (ft_strchr_local(charset, *str))
-			str++;
+		while (*str && ft_strchr_local(charset, *str))
+			*str++ = '\0';
 		if (*str)
-		{
-			matrix[i] = ft_addstr(str, charset);
-			if (!matrix[i])
-			{
-				free_split_matrix(matrix, i - 1);
-				return (0);
-			}
-			i++;
-		}
-		while (!ft_strchr_local(charset, *str) && *str)
+			matrix[i++] = str;
+		while (*str && !ft_strchr_local(charset, *str))
 			str++;
 	}
 	matrix[i] = NULL;
-	return (1);
 }
 
+/*
+** The pointer table and a copy of s share one allocation, so a split line
+** costs a single malloc and free_matrix a single free.
+*/
 char	**ft_split_rt(char const *s, char *charset)
 {
-	int		size;
+	size_t	table;
+	size_t	len;
 	char	**matrix;
 
 	if (!s)
 		return (NULL);
-	size = count_words((char *)s, charset);
-	matrix = malloc((size + 1) * sizeof(char *));
+	table = (count_words((char *)s, charset) + 1) * sizeof(char *);
+	len = ft_strlen(s);
+	matrix = malloc(table + len + 1);
 	if (matrix == NULL)
 		return (NULL);
-	if (!populate(matrix, (char *)s, charset))
-		return (NULL);
+	ft_memcpy((char *)matrix + table, s, len + 1);
+	populate(matrix, (char *)matrix + table, charset);
 	return (matrix);
 }
@@ -0,0 +1,110 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   texture_cache_bonus.c                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 21:59:24 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 02:40:51 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+#include "../../includes/texture_bonus.h"
+#include "../MLX42/include/MLX42/MLX42.h"
+#include <sys/stat.h>
+
+static t_tex_entry	*find_entry(t_tex_cache *cache, char *path,
+		struct stat *st)
+{
+	t_tex_entry	*entry;
+	size_t		len;
+
+	len = ft_strlen(path) + 1;
+	entry = cache->entries;
+	while (entry)
+	{
+		if (entry->size == st->st_size
+			&& entry->mtime.tv_sec == st->st_mtim.tv_sec
+			&& entry->mtime.tv_nsec == st->st_mtim.tv_nsec
+			&& ft_strncmp(entry->path, path, len) == 0)
+			return (entry);
+		entry = entry->next;
+	}
+	return (NULL);
+}
+
+static mlx_texture_t	*load_png(char *path)
+{
+	uint64_t		start;
+	mlx_texture_t	*texture;
+
+	start = prof_now();
+	texture = mlx_load_png(path);
+	prof_span("texture_load", start, -1);
+	return (texture);
+}
+
+/*
+** Decoded texture for path, shared with every other material (in this or
+** an earlier parse) that uses the same file unchanged. Without a cache
+** this is a plain mlx_load_png.
+*/
+mlx_texture_t	*texture_acquire(t_tex_cache *cache, char *path)
+{
+	struct stat	st;
+	t_tex_entry	*entry;
+
+	if (!cache || stat(path, &st) != 0)
+		return (load_png(path));
+	entry = find_entry(cache, path, &st);
+	if (entry)
+	{
+		entry->refs++;
+		cache->hits++;
+		return (entry->texture);
+	}
+	entry = ft_calloc(1, sizeof(t_tex_entry));
+	if (entry)
+		entry->path = ft_strdup(path);
+	if (entry && entry->path)
+		entry->texture = load_png(path);
+	if (!entry || !entry->texture)
+	{
+		if (entry)
+			free(entry->path);
+		return (free(entry), NULL);
+	}
+	entry->size = st.st_size;
+	entry->mtime = st.st_mtim;
+	entry->refs = 1;
+	entry->next = cache->entries;
+	cache->entries = entry;
+	cache->loads++;
+	return (entry->texture);
+}
+
+void	texture_release(t_tex_cache *cache, mlx_texture_t *texture)
+{
+	t_tex_entry	**link;
+	t_tex_entry	*entry;
+
+	link = NULL;
+	if (cache)
+		link = &cache->entries;
+	while (link && *link && (*link)->texture != texture)
+		link = &(*link)->next;
+	if (!link || !*link)
+	{
+		mlx_delete_texture(texture);
+		return ;
+	}
+	entry = *link;
+	if (--entry->refs > 0)
+		return ;
+	*link = entry->next;
+	mlx_delete_texture(entry->texture);
+	free(entry->path);
+	free(entry);
+}
@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/26 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2025/12/28 16:01:41 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 00:16:31 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -67,14 +67,13 @@ bool	parse_texture_strength(char *param_str, float *out_strength)
 }
 
 /*
- * Load a texture and validate it
+ * Load a texture (or reuse the cached decode) and validate it
  */
-static mlx_texture_t	*load_texture(char *path, mlx_t *mlx)
+static mlx_texture_t	*load_texture(char *path, t_tex_cache *textures)
 {
 	mlx_texture_t	*texture;
 
-	(void)mlx;
-	texture = mlx_load_png(path);
+	texture = texture_acquire(textures, path);
 	if (!texture)
 	{
 		printf("Error: Failed to load texture '%s'\n", path);
@@ -89,7 +88,8 @@ static mlx_texture_t	*load_texture(char *path, mlx_t *mlx)
 /*
  * Load material textures from scene file parameters
  */
-bool	load_material_textures(t_material *material, char **params, mlx_t *mlx)
+bool	load_material_textures(t_material *material, char **params,
+			t_tex_cache *textures)
 {
 	int		i;
 	char	*path;
@@ -118,7 +118,7 @@ bool	load_material_textures(t_material *material, char **params, mlx_t *mlx)
 				printf("Error: Invalid bump map path in '%s'\n", params[i]);
 				return (false);
 			}
-			material->bump_map = load_texture(path, mlx);
+			material->bump_map = load_texture(path, textures);
 			free(path);
 			if (!material->bump_map)
 				return (false);
@@ -145,7 +145,7 @@ bool	load_material_textures(t_material *material, char **params, mlx_t *mlx)
 				printf("Error: Invalid normal map path in '%s'\n", params[i]);
 				return (false);
 			}
-			material->normal_map = load_texture(path, mlx);
+			material->normal_map = load_texture(path, textures);
 			free(path);
 			if (!material->normal_map)
 				return (false);
@@ -172,7 +172,7 @@ bool	load_material_textures(t_material *material, char **params, mlx_t *mlx)
 				printf("Error: Invalid texture path in '%s'\n", params[i]);
 				return (false);
 			}
-			material->color_texture = load_texture(path, mlx);
+			material->color_texture = load_texture(path, textures);
 			free(path);
 			if (!material->color_texture)
 				return (false);
@@ -185,27 +185,27 @@ bool	load_material_textures(t_material *material, char **params, mlx_t *mlx)
 }
 
 /*
- * Free texture resources
+ * Free texture resources (or drop this material's hold on cached ones)
  */
-void	free_material_textures(t_material *material)
+void	free_material_textures(t_material *material, t_tex_cache *textures)
 {
 	if (!material)
 		return ;
 	if (material->bump_map)
 	{
-		mlx_delete_texture(material->bump_map);
+		texture_release(textures, material->bump_map);
 		material->bump_map = NULL;
 		material->has_bump_map = false;
 	}
 	if (material->normal_map)
 	{
-		mlx_delete_texture(material->normal_map);
+		texture_release(textures, material->normal_map);
 		material->normal_map = NULL;
 		material->has_normal_map = false;
 	}
 	if (material->color_texture)
 	{
-		mlx_delete_texture(material->color_texture);
+		texture_release(textures, material->color_texture);
 		material->color_texture = NULL;
 		material->has_color_texture = false;
 	}
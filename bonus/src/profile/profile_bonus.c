@@ -0,0 +1,131 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   profile_bonus.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 02:11:59 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 02:11:59 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+static t_prof_ring				*g_rings;
+static int						g_next_tid;
+static __thread t_prof_ring		*g_ring;
+static pthread_key_t			g_ring_key;
+static pthread_once_t			g_once = PTHREAD_ONCE_INIT;
+
+/*
+** A thread that exits hands its ring back; the next thread to start
+** claims it, so render threads restarted for every render reuse rings
+** instead of allocating new ones.
+*/
+static void	release_ring(void *ring)
+{
+	__atomic_store_n(&((t_prof_ring *)ring)->busy, false, __ATOMIC_RELEASE);
+}
+
+static void	prof_init(void)
+{
+	pthread_key_create(&g_ring_key, release_ring);
+	atexit(prof_dump);
+}
+
+static t_prof_ring	*claim_ring(void)
+{
+	t_prof_ring	*ring;
+	bool		idle;
+
+	ring = __atomic_load_n(&g_rings, __ATOMIC_ACQUIRE);
+	while (ring)
+	{
+		idle = false;
+		if (__atomic_compare_exchange_n(&ring->busy, &idle, true, false,
+				__ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+			return (ring);
+		ring = ring->next;
+	}
+	ring = ft_calloc(1, sizeof(t_prof_ring));
+	if (!ring)
+		return (NULL);
+	ring->busy = true;
+	ring->thread = "thread";
+	ring->tid = __atomic_add_fetch(&g_next_tid, 1, __ATOMIC_RELAXED);
+	ring->next = __atomic_load_n(&g_rings, __ATOMIC_ACQUIRE);
+	while (!__atomic_compare_exchange_n(&g_rings, &ring->next, ring, true,
+			__ATOMIC_RELEASE, __ATOMIC_ACQUIRE))
+		;
+	return (ring);
+}
+
+static t_prof_ring	*thread_ring(void)
+{
+	if (!g_ring)
+	{
+		pthread_once(&g_once, prof_init);
+		g_ring = claim_ring();
+		if (g_ring)
+			pthread_setspecific(g_ring_key, g_ring);
+	}
+	return (g_ring);
+}
+
+uint64_t	prof_now(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec);
+}
+
+/*
+** Records [start, now) on the calling thread's ring. Only this thread
+** writes the ring; the count is published last so a reader never sees a
+** half-written span.
+*/
+void	prof_span(const char *name, uint64_t start, int arg)
+{
+	t_prof_ring	*ring;
+	uint64_t	count;
+
+	ring = thread_ring();
+	if (!ring)
+		return ;
+	count = ring->count;
+	ring->spans[count % PROF_RING_SIZE] = (t_prof_span){name, start,
+		prof_now(), arg};
+	__atomic_store_n(&ring->count, count + 1, __ATOMIC_RELEASE);
+}
+
+void	prof_thread(const char *name)
+{
+	t_prof_ring	*ring;
+
+	ring = thread_ring();
+	if (ring)
+		ring->thread = name;
+}
+
+/*
+** A forked worker starts with a copy of the parent's rings; it keeps them
+** (and its thread lanes) but drops the parent's spans.
+*/
+void	prof_fork(void)
+{
+	t_prof_ring	*ring;
+
+	ring = __atomic_load_n(&g_rings, __ATOMIC_ACQUIRE);
+	while (ring)
+	{
+		ring->count = 0;
+		ring = ring->next;
+	}
+}
+
+t_prof_ring	*prof_rings(void)
+{
+	return (__atomic_load_n(&g_rings, __ATOMIC_ACQUIRE));
+}
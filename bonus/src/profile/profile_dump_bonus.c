@@ -0,0 +1,78 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   profile_dump_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 02:19:12 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 00:12:38 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+static void	dump_ring(FILE *out, t_prof_ring *ring, bool *first)
+{
+	uint64_t	count;
+	uint64_t	i;
+	t_prof_span	*s;
+
+	count = __atomic_load_n(&ring->count, __ATOMIC_ACQUIRE);
+	if (!*first)
+		fprintf(out, ",");
+	fprintf(out, "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,"
+		"\"tid\":%d,\"args\":{\"name\":\"%s\"}}", getpid(), ring->tid,
+		ring->thread);
+	*first = false;
+	i = 0;
+	if (count > PROF_RING_SIZE)
+		i = count - PROF_RING_SIZE;
+	while (i < count)
+	{
+		s = &ring->spans[i % PROF_RING_SIZE];
+		fprintf(out, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,"
+			"\"ts\":%.3f,\"dur\":%.3f", s->name, getpid(), ring->tid,
+			s->start / 1e3, (s->end - s->start) / 1e3);
+		if (s->arg >= 0)
+			fprintf(out, ",\"args\":{\"index\":%d}", s->arg);
+		fprintf(out, "}");
+		i++;
+	}
+}
+
+/*
+** Chrome trace event format ("X" complete events, microseconds), which
+** chrome://tracing and ui.perfetto.dev both open. Runs at exit, once the
+** render threads are joined. Every process (coordinator, each forked
+** worker) writes its own file, named after its pid.
+*/
+void	prof_dump(void)
+{
+	char		path[4096];
+	char		*file;
+	FILE		*out;
+	t_prof_ring	*ring;
+	bool		first;
+
+	file = getenv("MINIRT_TRACE_FILE");
+	if (!file)
+		snprintf(path, sizeof(path), PROF_FILE, getpid());
+	else if (snprintf(path, sizeof(path), PROF_FILE_ENV, file, getpid())
+		>= (int)sizeof(path))
+		return ;
+	out = fopen(path, "w");
+	if (!out)
+		return ;
+	fprintf(out, "{\"traceEvents\":[");
+	first = true;
+	ring = prof_rings();
+	while (ring)
+	{
+		dump_ring(out, ring, &first);
+		ring = ring->next;
+	}
+	fprintf(out, "\n],\"displayTimeUnit\":\"ms\"}\n");
+	fclose(out);
+	printf("📈 Trace written to %s\n", path);
+}
@@ -0,0 +1,147 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   anim_bonus.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 13:01:29 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 13:01:29 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+/*
+** Linear between the keys around `time`, held at the first and last.
+*/
+static t_tuple	sample_keys(t_anim_key *keys, int count, float time)
+{
+	int		i;
+	float	f;
+
+	if (time <= keys[0].time)
+		return (keys[0].value);
+	i = 1;
+	while (i < count && keys[i].time < time)
+		i++;
+	if (i == count)
+		return (keys[count - 1].value);
+	f = (time - keys[i - 1].time) / (keys[i].time - keys[i - 1].time);
+	return (add_tuple(keys[i - 1].value, tuple_scalar_mult(
+				substract_tuple(keys[i].value, keys[i - 1].value), f)));
+}
+
+static t_tuple	track_value(t_track *track, t_anim_prop prop, float time,
+	t_tuple rest)
+{
+	if (track->count[prop] == 0)
+		return (rest);
+	return (sample_keys(track->keys[prop], track->count[prop], time));
+}
+
+/*
+** Rotates the rest pose about its own origin, then moves that origin to
+** pos: T(pos) Rz Ry Rx T(-origin) rest. A cone is intersected from its
+** world centre and axis, so those follow too. Only this object's box is
+** refitted; mesh BVHs live in object space and stay as built.
+*/
+static void	pose_object(t_track *track, float time)
+{
+	t_object	*obj;
+	t_matrix	*trans;
+	t_matrix	*inv;
+	t_matrix	m;
+	t_tuple		origin;
+	t_tuple		v;
+
+	obj = track->target;
+	origin = (t_tuple){track->rest.mtrx[0][3], track->rest.mtrx[1][3],
+		track->rest.mtrx[2][3], 1};
+	m = translation(-origin.x, -origin.y, -origin.z);
+	v = track_value(track, PROP_ROT, time, (t_tuple){0, 0, 0, 0});
+	m = multiply_matrix(rotation_x(v.x * M_PI / 180.0), m);
+	m = multiply_matrix(rotation_y(v.y * M_PI / 180.0), m);
+	m = multiply_matrix(rotation_z(v.z * M_PI / 180.0), m);
+	v = track_value(track, PROP_POS, time, origin);
+	m = multiply_matrix(translation(v.x, v.y, v.z), m);
+	object_transforms(obj, &trans, &inv);
+	*trans = multiply_matrix(m, track->rest);
+	*inv = inverse_matrix(*trans);
+	if (obj->type == OBJ_CONE)
+	{
+		obj->shape.co.center = multiply_matrix_by_tuple(m, track->rest_center);
+		obj->shape.co.axis = normalizing_vector(
+				multiply_matrix_by_tuple(m, track->rest_axis));
+	}
+	obj->bounds = object_bounds(obj);
+}
+
+static void	pose_camera(t_data *data, t_track *track, float time)
+{
+	if (data->opts.job.has_camera)
+		return ;
+	data->cam.from = track_value(track, PROP_POS, time, track->rest_center);
+	data->cam.to = track_value(track, PROP_LOOK, time, track->rest_axis);
+	data->cam.transform = view_transformation(data->cam.from, data->cam.to,
+			data->cam.up);
+}
+
+/*
+** Poses every animated element for `time` (seconds) in the set-up world.
+** Only what depends on the moved elements is rebuilt: the light tree when
+** a light moved, and the occluder lists, which depend on where objects,
+** lights and the eye are.
+*/
+void	anim_apply(t_data *data, float time)
+{
+	t_track		*track;
+	bool		lights;
+	uint64_t	start;
+
+	if (!data->anim.tracks)
+		return ;
+	start = prof_now();
+	lights = false;
+	track = data->anim.tracks;
+	while (track)
+	{
+		if (track->kind == ANIM_CAMERA)
+			pose_camera(data, track, time);
+		else if (track->kind == ANIM_OBJECT)
+			pose_object(track, time);
+		else if (track->kind == ANIM_LIGHT)
+		{
+			((t_light *)track->target)->origin = track_value(track, PROP_POS,
+					time, track->rest_center);
+			lights = true;
+		}
+		track = track->next;
+	}
+	if (lights)
+	{
+		data->world.light_tree = NULL;
+		if (build_light_tree(&data->light_tree, data->light,
+				data->world.trace.light_cutoff))
+			data->world.light_tree = &data->light_tree;
+	}
+	build_light_occluders(&data->world, data->cam.from);
+	prof_span("anim_apply", start, -1);
+}
+
+void	anim_free(t_anim *anim)
+{
+	t_track		*next;
+	t_anim_prop	prop;
+
+	while (anim->tracks)
+	{
+		next = anim->tracks->next;
+		prop = PROP_POS;
+		while (prop < ANIM_PROPS)
+			free(anim->tracks->keys[prop++]);
+		free(anim->tracks);
+		anim->tracks = next;
+	}
+	*anim = (t_anim){};
+}
@@ -0,0 +1,177 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   checkpoint_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 17:54:02 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 10:58:48 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+/*
+** Pixels depend on the scene file and on every job setting, so all of
+** them go into the key (field by field: struct padding is not hashed).
+*/
+bool	checkpoint_key(t_data *data, uint64_t *key)
+{
+	t_job	*job;
+
+	job = &data->opts.job;
+	if (!scene_hash(data->opts.scene, key))
+		return (false);
+	*key = hash_bytes(*key, &job->width, sizeof(job->width));
+	*key = hash_bytes(*key, &job->height, sizeof(job->height));
+	*key = hash_bytes(*key, &job->samples, sizeof(job->samples));
+	*key = hash_bytes(*key, &data->region, sizeof(data->region));
+	*key = hash_bytes(*key, &job->has_camera, sizeof(job->has_camera));
+	*key = hash_bytes(*key, &job->eye, sizeof(job->eye));
+	*key = hash_bytes(*key, &job->dir, sizeof(job->dir));
+	*key = hash_bytes(*key, &job->fov, sizeof(job->fov));
+	*key = hash_bytes(*key, &job->trace.min_weight,
+			sizeof(job->trace.min_weight));
+	*key = hash_bytes(*key, &job->trace.russian_roulette,
+			sizeof(job->trace.russian_roulette));
+	*key = hash_bytes(*key, &job->trace.light_cutoff,
+			sizeof(job->trace.light_cutoff));
+	*key = hash_bytes(*key, &job->trace.light_samples,
+			sizeof(job->trace.light_samples));
+	return (true);
+}
+
+static bool	tile_io(t_data *data, FILE *file, int index, bool load)
+{
+	t_tile	tile;
+	float	*row;
+	int		y;
+
+	tile = region_tile(data->region, index);
+	y = 0;
+	while (y < tile.h)
+	{
+		row = &data->fb.rgb[((size_t)(tile.y + y) * data->fb.width
+				+ tile.x) * 3];
+		if (load && fread(row, sizeof(float), tile.w * 3, file)
+			!= (size_t)tile.w * 3)
+			return (false);
+		if (!load && fwrite(row, sizeof(float), tile.w * 3, file)
+			!= (size_t)tile.w * 3)
+			return (false);
+		y++;
+	}
+	return (true);
+}
+
+static bool	write_tiles(t_data *data, FILE *file, unsigned char *done)
+{
+	int	i;
+
+	i = 0;
+	while (i < data->total_tiles)
+	{
+		if (done[i] && !tile_io(data, file, i, false))
+			return (false);
+		i++;
+	}
+	return (true);
+}
+
+/*
+** Snapshots the done flags under the render mutex (the only time render
+** threads can be held up, for a memcpy), then writes those tiles to a
+** temporary file and renames it over the checkpoint so a kill mid-write
+** never leaves a torn file. Done tiles are never written again, so their
+** pixels can be read without the lock.
+*/
+bool	checkpoint_write(t_data *data)
+{
+	t_ckpt_header	header;
+	unsigned char	*done;
+	char			*tmp;
+	FILE			*file;
+	bool			ok;
+
+	done = malloc(data->total_tiles);
+	tmp = ft_strjoin(data->opts.checkpoint, ".tmp");
+	file = NULL;
+	if (done && tmp)
+		file = fopen(tmp, "wb");
+	if (!file)
+		return (free(done), free(tmp), false);
+	pthread_mutex_lock(&data->render_mutex);
+	ft_memcpy(done, data->tile_done, data->total_tiles);
+	pthread_mutex_unlock(&data->render_mutex);
+	header = (t_ckpt_header){CHECKPOINT_MAGIC, data->ckpt.key,
+		data->fb.width, data->fb.height, TILE_SIZE, data->total_tiles};
+	ok = fwrite(&header, sizeof(header), 1, file) == 1
+		&& fwrite(done, 1, data->total_tiles, file)
+		== (size_t)data->total_tiles
+		&& write_tiles(data, file, done);
+	ok = fclose(file) == 0 && ok && rename(tmp, data->opts.checkpoint) == 0;
+	if (!ok)
+		unlink(tmp);
+	return (free(done), free(tmp), ok);
+}
+
+static bool	read_tiles(t_data *data, FILE *file, t_ckpt_header *header)
+{
+	int	i;
+
+	if (ft_memcmp(header->magic, CHECKPOINT_MAGIC, sizeof(header->magic))
+		|| header->key != data->ckpt.key || header->width != data->fb.width
+		|| header->height != data->fb.height
+		|| header->tile_size != TILE_SIZE
+		|| header->total_tiles != data->total_tiles
+		|| fread(data->tile_done, 1, data->total_tiles, file)
+		!= (size_t)data->total_tiles)
+		return (false);
+	i = 0;
+	while (i < data->total_tiles)
+	{
+		if (data->tile_done[i])
+		{
+			if (!tile_io(data, file, i, true))
+				return (false);
+			data->tiles_done++;
+		}
+		i++;
+	}
+	return (true);
+}
+
+/*
+** --resume: restores the done tiles of a matching checkpoint into the
+** framebuffer and marks them so the scheduler skips them. Anything that
+** does not match (another scene, other settings, a short file) is
+** ignored and the render starts from scratch.
+*/
+void	checkpoint_load(t_data *data)
+{
+	t_ckpt_header	header;
+	FILE			*file;
+	bool			ok;
+
+	file = fopen(data->opts.checkpoint, "rb");
+	if (!file)
+	{
+		printf("⚠️  No checkpoint at %s, starting fresh\n",
+			data->opts.checkpoint);
+		return ;
+	}
+	ok = fread(&header, sizeof(header), 1, file) == 1
+		&& read_tiles(data, file, &header);
+	fclose(file);
+	if (ok)
+	{
+		printf("♻️  Resumed %d/%d tiles from %s\n", data->tiles_done,
+			data->total_tiles, data->opts.checkpoint);
+		return ;
+	}
+	ft_bzero(data->tile_done, data->total_tiles);
+	data->tiles_done = 0;
+	printf("⚠️  %s does not match this render, starting fresh\n",
+		data->opts.checkpoint);
+}
@@ -0,0 +1,100 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   checkpoint_thread_bonus.c                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 18:01:15 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 03:45:48 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+#include <time.h>
+
+static struct timespec	deadline_in(float seconds)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	ts.tv_sec += (time_t)seconds;
+	ts.tv_nsec += (long)((seconds - (time_t)seconds) * 1e9);
+	if (ts.tv_nsec >= 1000000000L)
+	{
+		ts.tv_sec++;
+		ts.tv_nsec -= 1000000000L;
+	}
+	return (ts);
+}
+
+/*
+** Sleeps on its own condition variable between writes, so the render
+** threads never wait on file I/O; checkpoint_stop wakes it early.
+*/
+static void	*checkpoint_thread(void *arg)
+{
+	t_data			*data;
+	struct timespec	deadline;
+	uint64_t		start;
+
+	data = (t_data *)arg;
+	prof_thread("checkpoint");
+	pthread_mutex_lock(&data->ckpt.lock);
+	deadline = deadline_in(data->opts.checkpoint_every);
+	while (!data->ckpt.quit)
+	{
+		if (pthread_cond_timedwait(&data->ckpt.wake, &data->ckpt.lock,
+				&deadline) == 0 || data->ckpt.quit)
+			continue ;
+		pthread_mutex_unlock(&data->ckpt.lock);
+		start = prof_now();
+		if (!checkpoint_write(data))
+			printf("⚠️  Could not write checkpoint %s\n",
+				data->opts.checkpoint);
+		prof_span("checkpoint", start, -1);
+		pthread_mutex_lock(&data->ckpt.lock);
+		deadline = deadline_in(data->opts.checkpoint_every);
+	}
+	pthread_mutex_unlock(&data->ckpt.lock);
+	return (NULL);
+}
+
+bool	checkpoint_start(t_data *data)
+{
+	data->ckpt.quit = false;
+	pthread_mutex_init(&data->ckpt.lock, NULL);
+	pthread_cond_init(&data->ckpt.wake, NULL);
+	if (pthread_create(&data->ckpt.thread, NULL, checkpoint_thread, data))
+	{
+		pthread_cond_destroy(&data->ckpt.wake);
+		pthread_mutex_destroy(&data->ckpt.lock);
+		return (false);
+	}
+	data->ckpt.running = true;
+	return (true);
+}
+
+/*
+** Called once the render threads have been joined: retires the writer and
+** saves a last checkpoint holding every tile that was finished, whether
+** the render completed or was interrupted.
+*/
+void	checkpoint_stop(t_data *data)
+{
+	if (!data->ckpt.running)
+		return ;
+	pthread_mutex_lock(&data->ckpt.lock);
+	data->ckpt.quit = true;
+	pthread_cond_signal(&data->ckpt.wake);
+	pthread_mutex_unlock(&data->ckpt.lock);
+	pthread_join(data->ckpt.thread, NULL);
+	pthread_cond_destroy(&data->ckpt.wake);
+	pthread_mutex_destroy(&data->ckpt.lock);
+	data->ckpt.running = false;
+	if (checkpoint_write(data))
+		printf("💾 Checkpoint: %d/%d tiles in %s\n", data->tiles_done,
+			data->total_tiles, data->opts.checkpoint);
+	else
+		printf("⚠️  Could not write checkpoint %s\n", data->opts.checkpoint);
+}
@@ -0,0 +1,161 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   framebuffer_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 13:19:48 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 03:09:43 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+bool	framebuffer_init(t_framebuffer *fb, int width, int height)
+{
+	fb->width = width;
+	fb->height = height;
+	fb->rgb = ft_calloc((size_t)width * height * 3, sizeof(float));
+	return (fb->rgb != NULL);
+}
+
+void	framebuffer_free(t_framebuffer *fb)
+{
+	free(fb->rgb);
+	fb->rgb = NULL;
+}
+
+void	framebuffer_store(t_framebuffer *fb, int x, int y, t_tuple color)
+{
+	float	*px;
+
+	px = &fb->rgb[((size_t)y * fb->width + x) * 3];
+	px[0] = color.x;
+	px[1] = color.y;
+	px[2] = color.z;
+}
+
+/*
+** Tile index -> pixel rectangle, row-major, clipped at the right and
+** bottom edges of a width x height frame.
+*/
+t_tile	tile_rect(int index, int tiles_x, int width, int height)
+{
+	t_tile	tile;
+
+	tile.x = (index % tiles_x) * TILE_SIZE;
+	tile.y = (index / tiles_x) * TILE_SIZE;
+	tile.w = width - tile.x;
+	if (tile.w > TILE_SIZE)
+		tile.w = TILE_SIZE;
+	tile.h = height - tile.y;
+	if (tile.h > TILE_SIZE)
+		tile.h = TILE_SIZE;
+	return (tile);
+}
+
+/*
+** Copies a packed tile.w x tile.h RGB block (as a worker returns it) into
+** its place in the frame.
+*/
+void	framebuffer_blit(t_framebuffer *fb, t_tile tile, float *rgb)
+{
+	int		y;
+
+	y = 0;
+	while (y < tile.h)
+	{
+		ft_memcpy(&fb->rgb[((size_t)(tile.y + y) * fb->width + tile.x) * 3],
+			&rgb[(size_t)y * tile.w * 3], (size_t)tile.w * 3 * sizeof(float));
+		y++;
+	}
+}
+
+/*
+** Quantises one finished tile into the RGBA8 image, a row at a time
+** straight into img->pixels (R, G, B, A bytes, as mlx_put_pixel lays them).
+*/
+void	framebuffer_resolve(t_framebuffer *fb, mlx_image_t *img, t_tile tile)
+{
+	float		*src;
+	uint8_t		*dst;
+	int			y;
+	int			x;
+	uint64_t	start;
+
+	start = prof_now();
+	y = tile.y;
+	while (y < tile.y + tile.h)
+	{
+		src = &fb->rgb[((size_t)y * fb->width + tile.x) * 3];
+		dst = &img->pixels[((size_t)y * img->width + tile.x) * 4];
+		x = 0;
+		while (x < tile.w)
+		{
+			dst[x * 4 + 0] = channel_to_byte(src[x * 3 + 0]);
+			dst[x * 4 + 1] = channel_to_byte(src[x * 3 + 1]);
+			dst[x * 4 + 2] = channel_to_byte(src[x * 3 + 2]);
+			dst[x * 4 + 3] = 0xFF;
+			x++;
+		}
+		y++;
+	}
+	prof_span("resolve", start, -1);
+}
+
+/*
+** Portable Float Map: unclamped linear RGB, rows bottom to top, negative
+** scale for little-endian floats.
+*/
+bool	framebuffer_to_pfm(t_framebuffer *fb, char *path)
+{
+	FILE	*output;
+	int		y;
+	size_t	row;
+
+	if (!fb->rgb)
+		return (false);
+	output = fopen(path, "wb");
+	if (!output)
+		return (false);
+	fprintf(output, "PF\n%d %d\n-1.0\n", fb->width, fb->height);
+	row = (size_t)fb->width * 3;
+	y = fb->height;
+	while (--y >= 0)
+	{
+		if (fwrite(&fb->rgb[y * row], sizeof(float), row, output) != row)
+			return (fclose(output), false);
+	}
+	return (fclose(output) == 0);
+}
+
+/*
+** Binary PPM of the clamped image, for renders that never had an MLX image.
+*/
+bool	framebuffer_to_ppm(t_framebuffer *fb, char *path)
+{
+	FILE	*output;
+	size_t	i;
+	size_t	count;
+	uint8_t	rgb[3];
+
+	if (!fb->rgb)
+		return (false);
+	output = fopen(path, "wb");
+	if (!output)
+		return (false);
+	fprintf(output, "P6\n%d %d\n255\n", fb->width, fb->height);
+	count = (size_t)fb->width * fb->height;
+	i = 0;
+	while (i < count)
+	{
+		rgb[0] = channel_to_byte(fb->rgb[i * 3 + 0]);
+		rgb[1] = channel_to_byte(fb->rgb[i * 3 + 1]);
+		rgb[2] = channel_to_byte(fb->rgb[i * 3 + 2]);
+		if (fwrite(rgb, 1, 3, output) != 3)
+			return (fclose(output), false);
+		i++;
+	}
+	return (fclose(output) == 0);
+}
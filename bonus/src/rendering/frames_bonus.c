@@ -0,0 +1,199 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   frames_bonus.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 13:08:42 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 13:08:42 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+/*
+** The writer side of a --frames run. While busy it owns fb and path and
+** saves them; the renderer waits for it to go idle before handing over
+** the next frame.
+*/
+typedef struct s_encoder
+{
+	pthread_t		thread;
+	pthread_mutex_t	mutex;
+	pthread_cond_t	cond;
+	t_framebuffer	fb;
+	char			*path;
+	bool			busy;
+	bool			failed;
+	bool			quit;
+}	t_encoder;
+
+static bool	write_frame(t_framebuffer *fb, char *path)
+{
+	char		*dot;
+	uint64_t	start;
+	bool		ok;
+
+	start = prof_now();
+	dot = ft_strrchr(path, '.');
+	if (dot && ft_strncmp(dot, ".pfm", 5) == 0)
+		ok = framebuffer_to_pfm(fb, path);
+	else
+		ok = framebuffer_to_ppm(fb, path);
+	prof_span("export", start, -1);
+	if (!ok)
+		printf("❌ Error: cannot write %s\n", path);
+	else
+		printf("💾 Saved %s\n", path);
+	return (ok);
+}
+
+static void	*encoder_thread(void *arg)
+{
+	t_encoder	*enc;
+	bool		ok;
+
+	enc = (t_encoder *)arg;
+	prof_thread("encoder");
+	pthread_mutex_lock(&enc->mutex);
+	while (!enc->quit || enc->busy)
+	{
+		if (!enc->busy)
+		{
+			pthread_cond_wait(&enc->cond, &enc->mutex);
+			continue ;
+		}
+		pthread_mutex_unlock(&enc->mutex);
+		ok = write_frame(&enc->fb, enc->path);
+		pthread_mutex_lock(&enc->mutex);
+		if (!ok)
+			enc->failed = true;
+		free(enc->path);
+		enc->path = NULL;
+		enc->busy = false;
+		pthread_cond_broadcast(&enc->cond);
+	}
+	pthread_mutex_unlock(&enc->mutex);
+	return (NULL);
+}
+
+/*
+** Waits until the previous frame is written, then trades buffers with the
+** writer: it takes the finished frame and the pool renders the next one
+** into the buffer that was just saved. Takes ownership of path.
+*/
+static bool	encoder_push(t_encoder *enc, t_framebuffer *fb, char *path)
+{
+	t_framebuffer	swap;
+	bool			ok;
+
+	pthread_mutex_lock(&enc->mutex);
+	while (enc->busy)
+		pthread_cond_wait(&enc->cond, &enc->mutex);
+	ok = path && !enc->failed;
+	if (ok)
+	{
+		swap = enc->fb;
+		enc->fb = *fb;
+		*fb = swap;
+		enc->path = path;
+		enc->busy = true;
+		pthread_cond_broadcast(&enc->cond);
+	}
+	pthread_mutex_unlock(&enc->mutex);
+	if (!ok)
+		free(path);
+	return (ok);
+}
+
+/*
+** <stem>_NNNN<ext> from --output, frame.ppm when none was given.
+*/
+static char	*frame_path(char *output, int index)
+{
+	char	*dot;
+	char	*path;
+	size_t	stem;
+	size_t	size;
+
+	if (!output)
+		output = "frame.ppm";
+	stem = ft_strlen(output);
+	dot = ft_strrchr(output, '.');
+	if (dot && !ft_strchr(dot, '/'))
+		stem = dot - output;
+	size = ft_strlen(output) + 16;
+	path = malloc(size);
+	if (!path)
+		return (printf("❌ Frames: Out of memory\n"), NULL);
+	snprintf(path, size, "%.*s_%04d%s", (int)stem, output, index,
+		output + stem);
+	return (path);
+}
+
+static bool	render_frames(t_data *data, t_render_pool *pool, t_encoder *enc)
+{
+	t_tile	region;
+	int		frame;
+	int		seen;
+	bool	ok;
+
+	job_region(&data->opts.job, &region);
+	ok = true;
+	frame = 0;
+	while (ok && frame < data->opts.frames)
+	{
+		anim_apply(data, frame / data->opts.fps);
+		ok = pool_submit(pool, data, region);
+		seen = 0;
+		while (ok && seen < pool->total_tiles)
+			seen = pool_collect(pool, seen);
+		ok = ok && encoder_push(enc, &pool->fb,
+				frame_path(data->opts.output, frame));
+		frame++;
+	}
+	return (ok);
+}
+
+/*
+** Headless image sequence. The scene is parsed and its textures loaded
+** once; frame i poses the animated elements for i / fps seconds, renders
+** on the tile pool and goes to the writer thread, which saves it while
+** frame i + 1 renders.
+*/
+int	run_frames(t_data *data)
+{
+	t_render_pool	pool;
+	t_encoder		enc;
+	t_camera		cam;
+	double			start;
+	bool			ok;
+
+	setup_world(data, &cam);
+	enc = (t_encoder){};
+	pthread_mutex_init(&enc.mutex, NULL);
+	pthread_cond_init(&enc.cond, NULL);
+	ok = pool_start(&pool, NUM_THREADS)
+		&& pthread_create(&enc.thread, NULL, encoder_thread, &enc) == 0;
+	printf("🎞️  %d frames at %g fps, animation lasts %g s\n",
+		data->opts.frames, data->opts.fps, data->anim.end);
+	start = net_clock();
+	if (ok)
+		ok = render_frames(data, &pool, &enc);
+	pthread_mutex_lock(&enc.mutex);
+	enc.quit = true;
+	pthread_cond_broadcast(&enc.cond);
+	pthread_mutex_unlock(&enc.mutex);
+	if (enc.thread)
+		pthread_join(enc.thread, NULL);
+	ok = ok && !enc.failed;
+	pool_stop(&pool);
+	framebuffer_free(&enc.fb);
+	pthread_cond_destroy(&enc.cond);
+	pthread_mutex_destroy(&enc.mutex);
+	if (!ok)
+		return (printf("❌ Frames: rendering stopped\n"), 1);
+	printf("✅ %d frames in %.3f s\n", data->opts.frames, net_clock() - start);
+	return (0);
+}
@@ -0,0 +1,130 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   frustum_bonus.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 19:38:24 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 20:57:47 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+/*
+** The planes bounding what a tile's primary rays can reach, as (a, b, c, d)
+** with a*x + b*y + c*z + d >= 0 inside: its four sides, each through the
+** eye, and the plane of the eye itself, since only hits ahead of it count.
+** They are set up in camera space, where the tile spans [lo, hi] on the
+** image plane z = -1, then taken to world space through cam.transform.
+** Sample jitter stays inside the pixel; the margin covers rounding.
+*/
+static void	tile_planes(t_camera cam, t_tile tile, float planes[5][4])
+{
+	float	n[5][3];
+	float	lo[2];
+	float	hi[2];
+	int		p;
+	int		j;
+
+	lo[0] = cam.half_width - (tile.x + tile.w + FRUSTUM_MARGIN)
+		* cam.pixel_size;
+	hi[0] = cam.half_width - (tile.x - FRUSTUM_MARGIN) * cam.pixel_size;
+	lo[1] = cam.half_height - (tile.y + tile.h + FRUSTUM_MARGIN)
+		* cam.pixel_size;
+	hi[1] = cam.half_height - (tile.y - FRUSTUM_MARGIN) * cam.pixel_size;
+	ft_memcpy(n, (float [5][3]){{1, 0, lo[0]}, {-1, 0, -hi[0]},
+		{0, 1, lo[1]}, {0, -1, -hi[1]}, {0, 0, -1}}, sizeof(n));
+	p = -1;
+	while (++p < 5)
+	{
+		j = -1;
+		while (++j < 4)
+			planes[p][j] = n[p][0] * cam.transform.mtrx[0][j]
+				+ n[p][1] * cam.transform.mtrx[1][j]
+				+ n[p][2] * cam.transform.mtrx[2][j];
+	}
+}
+
+/*
+** A box is out of the frustum when even its corner furthest along some
+** plane's normal is behind that plane. Unbounded objects are always kept.
+*/
+static bool	in_frustum(float planes[5][4], t_object *obj)
+{
+	float	box[2][3];
+	float	reach;
+	int		p;
+	int		j;
+
+	if (!obj->bounds.finite)
+		return (true);
+	ft_memcpy(box, (float [2][3]){{obj->bounds.min.x, obj->bounds.min.y,
+		obj->bounds.min.z}, {obj->bounds.max.x, obj->bounds.max.y,
+		obj->bounds.max.z}}, sizeof(box));
+	p = -1;
+	while (++p < 5)
+	{
+		reach = planes[p][3];
+		j = -1;
+		while (++j < 3)
+			reach += planes[p][j] * box[planes[p][j] > 0.0f][j];
+		if (reach < 0.0f)
+			return (false);
+	}
+	return (true);
+}
+
+static int	count_candidates(t_world *world)
+{
+	t_object	*obj;
+	t_object	**set;
+	int			count;
+
+	count = 0;
+	set = world->primary;
+	while (set && set[count])
+		count++;
+	obj = world->objects;
+	while (!set && obj && ++count)
+		obj = obj->next;
+	return (count);
+}
+
+/*
+** The NULL-terminated objects whose bounds meet the view frustum of tile
+** (in frame pixels), picked from world->primary when it is set, so a
+** frame's set narrows down to its tiles' sets. NULL if out of memory,
+** which leaves primary rays testing every object. The caller frees it.
+*/
+t_object	**frustum_objects(t_world *world, t_camera cam, t_tile tile)
+{
+	float		planes[5][4];
+	t_object	**visible;
+	t_object	**set;
+	t_object	*obj;
+	int			count;
+
+	visible = malloc(sizeof(t_object *) * (count_candidates(world) + 1));
+	if (!visible)
+		return (NULL);
+	tile_planes(cam, tile, planes);
+	count = 0;
+	set = world->primary;
+	while (set && *set)
+	{
+		if (in_frustum(planes, *set))
+			visible[count++] = *set;
+		set++;
+	}
+	obj = world->objects;
+	while (!world->primary && obj)
+	{
+		if (in_frustum(planes, obj))
+			visible[count++] = obj;
+		obj = obj->next;
+	}
+	visible[count] = NULL;
+	return (visible);
+}
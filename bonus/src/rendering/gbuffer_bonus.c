@@ -0,0 +1,123 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   gbuffer_bonus.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 20:32:48 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 09:03:20 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+/*
+** Allocates the buffer on first use and records the camera origin every
+** primary ray starts from (ray_for_pixel computes the same one for all).
+*/
+bool	gbuffer_prepare(t_gbuffer *gb, t_camera cam)
+{
+	if (!gb->px)
+	{
+		gb->width = (int)cam.h_view;
+		gb->height = (int)cam.v_view;
+		gb->px = ft_calloc((size_t)gb->width * gb->height, sizeof(t_gsample));
+		if (!gb->px)
+			return (false);
+	}
+	gb->origin = ray_for_pixel(cam, 0, 0).origin;
+	return (true);
+}
+
+/*
+** Records are trusted only once a full-frame fill has finished every tile.
+** Called before anything reads or refills the buffer, with no render
+** running, to settle the previous fill.
+*/
+bool	gbuffer_usable(t_data *data)
+{
+	if (data->gbuf.filling && data->tiles_done >= data->total_tiles)
+		data->gbuf.valid = true;
+	data->gbuf.filling = false;
+	return (data->gbuf.px && data->gbuf.valid);
+}
+
+void	gbuffer_free(t_gbuffer *gb)
+{
+	free(gb->px);
+	gb->px = NULL;
+}
+
+/*
+** Rebuilds the hit record prepare_computations made for this pixel: both
+** offset points move along the final normal, which is also what it does.
+*/
+static bool	gbuffer_comps(t_gbuffer *gb, int x, int y, t_comps *comps)
+{
+	t_gsample	*s;
+	t_ray		ray;
+	float		eps;
+
+	s = &gb->px[(size_t)y * gb->width + x];
+	if (!s->obj)
+		return (false);
+	ray = (t_ray){gb->origin, s->direction};
+	comps->t = s->t;
+	comps->obj = s->obj;
+	comps->inst = s->inst;
+	comps->point = position(ray, s->t);
+	comps->obj_point = comps->point;
+	if (s->inst)
+		comps->obj_point = multiply_matrix_by_tuple(s->inst->trans_inv,
+				comps->point);
+	comps->eyev = negate_tuple(ray.direction);
+	comps->normalv = s->normalv;
+	comps->inside = s->inside;
+	eps = adaptive_epsilon(s->t);
+	comps->over_point = add_tuple(comps->point,
+			tuple_scalar_mult(s->normalv, eps));
+	comps->under_point = substract_tuple(comps->point,
+			tuple_scalar_mult(s->normalv, eps));
+	comps->reflectv = reflect(ray.direction, s->normalv);
+	comps->uv = (t_tuple){s->u, s->v, 0, 0};
+	comps->n1 = s->n1;
+	comps->n2 = s->n2;
+	return (true);
+}
+
+/*
+** One sample per pixel, like trace_pixel, recording the first hit on the
+** way.
+*/
+t_tuple	trace_gbuffer_pixel(t_gbuffer *gb, t_world world, t_camera cam,
+		int xy[2])
+{
+	t_gsample	*s;
+	t_ray		ray;
+	t_comps		comps;
+
+	s = &gb->px[(size_t)xy[1] * gb->width + xy[0]];
+	ray = ray_for_pixel(cam, (double)xy[0], (double)xy[1]);
+	if (!first_hit(&world, ray, &comps))
+	{
+		s->obj = NULL;
+		return ((t_tuple){0, 0, 0, 0});
+	}
+	*s = (t_gsample){comps.obj, comps.inst, ray.direction, comps.normalv, comps.t,
+		comps.n1, comps.n2, comps.uv.x, comps.uv.y, comps.inside};
+	return (color_from_hit(world, &comps, MAX_REFLECTION_DEPTH, 1.0f));
+}
+
+/*
+** Shades a pixel again from its stored first hit: lights, shadows and
+** secondary rays are traced, the primary ray is not.
+*/
+t_tuple	relight_pixel(t_gbuffer *gb, t_world world, int x, int y)
+{
+	t_comps	comps;
+
+	if (!gbuffer_comps(gb, x, y, &comps))
+		return ((t_tuple){0, 0, 0, 0});
+	return (color_from_hit(world, &comps, MAX_REFLECTION_DEPTH, 1.0f));
+}
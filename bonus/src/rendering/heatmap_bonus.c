@@ -0,0 +1,120 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   heatmap_bonus.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 00:30:57 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 00:30:57 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+/*
+** One float plane per cost metric, allocated on first use and kept, like
+** the framebuffer, so region renders update the same maps.
+*/
+bool	heatmap_prepare(t_heatmap *hm, int width, int height)
+{
+	t_heat	m;
+
+	if (hm->view.rgb)
+		return (true);
+	hm->width = width;
+	hm->height = height;
+	hm->shown = HEAT_COLOR;
+	m = HEAT_TIME;
+	while (m < HEAT_VIEWS)
+	{
+		hm->plane[m] = ft_calloc((size_t)width * height, sizeof(float));
+		if (!hm->plane[m])
+			return (heatmap_free(hm), false);
+		m++;
+	}
+	if (!framebuffer_init(&hm->view, width, height))
+		return (heatmap_free(hm), false);
+	return (true);
+}
+
+void	heatmap_free(t_heatmap *hm)
+{
+	t_heat	m;
+
+	m = HEAT_COLOR;
+	while (m < HEAT_VIEWS)
+	{
+		free(hm->plane[m]);
+		hm->plane[m] = NULL;
+		m++;
+	}
+	framebuffer_free(&hm->view);
+}
+
+/*
+** CPU time of the calling thread: with more render threads than cores,
+** wall time would also count the time a thread spent preempted.
+*/
+double	heat_clock(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}
+
+void	heatmap_record(t_heatmap *hm, int x, int y, t_ray_stats *stats)
+{
+	size_t	i;
+
+	i = (size_t)y * hm->width + x;
+	hm->plane[HEAT_TIME][i] = stats->seconds;
+	hm->plane[HEAT_TESTS][i] = (float)stats->tests;
+	hm->plane[HEAT_SHADOWS][i] = (float)stats->shadow_rays;
+	hm->plane[HEAT_DEPTH][i] = (float)stats->depth;
+}
+
+char	*heat_name(t_heat metric)
+{
+	if (metric == HEAT_TIME)
+		return ("time");
+	if (metric == HEAT_TESTS)
+		return ("tests");
+	if (metric == HEAT_SHADOWS)
+		return ("shadows");
+	if (metric == HEAT_DEPTH)
+		return ("depth");
+	return ("color");
+}
+
+/*
+** Frame totals and the costliest pixel of each map, so a pathological
+** object can be found from the terminal too.
+*/
+void	heatmap_report(t_heatmap *hm)
+{
+	t_heat	m;
+	size_t	i;
+	size_t	worst;
+	double	sum;
+
+	m = HEAT_TIME;
+	while (m < HEAT_VIEWS)
+	{
+		sum = 0.0;
+		worst = 0;
+		i = 0;
+		while (i < (size_t)hm->width * hm->height)
+		{
+			sum += hm->plane[m][i];
+			if (hm->plane[m][i] > hm->plane[m][worst])
+				worst = i;
+			i++;
+		}
+		printf("🔥 %-7s total %12.6g  max %10.6g at (%zu, %zu)\n",
+			heat_name(m), sum, hm->plane[m][worst], worst % hm->width,
+			worst / hm->width);
+		m++;
+	}
+}
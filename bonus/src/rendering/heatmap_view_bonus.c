@@ -0,0 +1,121 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   heatmap_view_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 00:38:10 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 00:38:10 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+/*
+** Black, purple, red, yellow, white: brighter is costlier, and the ramp
+** still reads in greyscale.
+*/
+static t_tuple	heat_color(float v)
+{
+	t_tuple	stops[5];
+	float	f;
+	int		i;
+
+	stops[0] = (t_tuple){0.0f, 0.0f, 0.0f, 0};
+	stops[1] = (t_tuple){0.35f, 0.0f, 0.6f, 0};
+	stops[2] = (t_tuple){0.9f, 0.1f, 0.1f, 0};
+	stops[3] = (t_tuple){1.0f, 0.8f, 0.0f, 0};
+	stops[4] = (t_tuple){1.0f, 1.0f, 1.0f, 0};
+	if (!(v > 0.0f))
+		return (stops[0]);
+	if (v >= 1.0f)
+		return (stops[4]);
+	i = (int)(v * 4.0f);
+	f = v * 4.0f - i;
+	return (add_tuple(tuple_scalar_mult(stops[i], 1.0f - f),
+			tuple_scalar_mult(stops[i + 1], f)));
+}
+
+/*
+** Depth is scaled to MAX_REFLECTION_DEPTH so pixels that run out of
+** bounces are white; the other maps are scaled to their frame maximum.
+*/
+static float	heat_scale(t_heatmap *hm, t_heat metric)
+{
+	size_t	i;
+	float	top;
+
+	if (metric == HEAT_DEPTH)
+		return (MAX_REFLECTION_DEPTH);
+	top = 0.0f;
+	i = 0;
+	while (i < (size_t)hm->width * hm->height)
+	{
+		if (hm->plane[metric][i] > top)
+			top = hm->plane[metric][i];
+		i++;
+	}
+	return (top);
+}
+
+static void	heat_colorize(t_heatmap *hm, t_heat metric)
+{
+	size_t	i;
+	float	scale;
+	t_tuple	c;
+
+	scale = heat_scale(hm, metric);
+	if (scale <= 0.0f)
+		scale = 1.0f;
+	i = 0;
+	while (i < (size_t)hm->width * hm->height)
+	{
+		c = heat_color(hm->plane[metric][i] / scale);
+		hm->view.rgb[i * 3 + 0] = c.x;
+		hm->view.rgb[i * 3 + 1] = c.y;
+		hm->view.rgb[i * 3 + 2] = c.z;
+		i++;
+	}
+}
+
+/*
+** Puts a cost map, or the render itself for HEAT_COLOR, in the window.
+*/
+void	heatmap_show(t_heatmap *hm, t_framebuffer *fb, mlx_image_t *img,
+		t_heat metric)
+{
+	t_tile	frame;
+
+	frame = (t_tile){0, 0, fb->width, fb->height};
+	hm->shown = metric;
+	if (metric == HEAT_COLOR)
+	{
+		framebuffer_resolve(fb, img, frame);
+		return ;
+	}
+	heat_colorize(hm, metric);
+	framebuffer_resolve(&hm->view, img, frame);
+}
+
+/*
+** heat_<metric>.ppm for every map, next to the screenshot.
+*/
+bool	heatmap_write(t_heatmap *hm)
+{
+	t_heat	m;
+	char	path[32];
+
+	m = HEAT_TIME;
+	while (m < HEAT_VIEWS)
+	{
+		snprintf(path, sizeof(path), "heat_%s.ppm", heat_name(m));
+		heat_colorize(hm, m);
+		if (!framebuffer_to_ppm(&hm->view, path))
+			return (printf("❌ Error: cannot write %s\n", path), false);
+		m++;
+	}
+	if (hm->shown != HEAT_COLOR)
+		heat_colorize(hm, hm->shown);
+	return (true);
+}
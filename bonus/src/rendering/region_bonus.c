@@ -0,0 +1,86 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   region_bonus.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 19:13:25 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 19:13:25 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+/*
+** The part of the frame a job traces: its region, or the whole frame when
+** the region is empty. False when the region sticks out of the frame.
+*/
+bool	job_region(t_job *job, t_tile *region)
+{
+	*region = job->region;
+	if (region->w <= 0 || region->h <= 0)
+		*region = (t_tile){0, 0, job->width, job->height};
+	return (region->x >= 0 && region->y >= 0
+		&& region->x + region->w <= job->width
+		&& region->y + region->h <= job->height);
+}
+
+int	region_tile_count(t_tile region)
+{
+	return (((region.w + TILE_SIZE - 1) / TILE_SIZE)
+		* ((region.h + TILE_SIZE - 1) / TILE_SIZE));
+}
+
+/*
+** Tile `index` of a region in frame coordinates: tiles start at the
+** region's corner and are clipped to its right and bottom edges, so a
+** region render never touches a pixel outside it.
+*/
+t_tile	region_tile(t_tile region, int index)
+{
+	t_tile	tile;
+
+	tile = tile_rect(index, (region.w + TILE_SIZE - 1) / TILE_SIZE,
+			region.w, region.h);
+	tile.x += region.x;
+	tile.y += region.y;
+	return (tile);
+}
+
+/*
+** Rectangle spanned by two corners of a mouse drag, in either order,
+** clipped to a width x height frame (empty if it misses the frame).
+*/
+t_tile	span_region(int32_t from[2], int32_t to[2], int width, int height)
+{
+	t_tile	region;
+	int		x1;
+	int		y1;
+
+	region.x = from[0];
+	x1 = to[0];
+	if (to[0] < from[0])
+	{
+		region.x = to[0];
+		x1 = from[0];
+	}
+	region.y = from[1];
+	y1 = to[1];
+	if (to[1] < from[1])
+	{
+		region.y = to[1];
+		y1 = from[1];
+	}
+	if (region.x < 0)
+		region.x = 0;
+	if (region.y < 0)
+		region.y = 0;
+	if (x1 > width)
+		x1 = width;
+	if (y1 > height)
+		y1 = height;
+	region.w = x1 - region.x;
+	region.h = y1 - region.y;
+	return (region);
+}
@@ -0,0 +1,183 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   relight_bonus.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 20:40:01 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 19:16:45 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+#include "../MLX42/include/MLX42/MLX42.h"
+
+/*
+** Lists are swapped with their tail pointers and the arenas that own them.
+*/
+static void	swap_lights(t_data *data, t_data *fresh)
+{
+	t_light	*lights;
+	t_arena	arena;
+
+	lights = data->light;
+	data->light = fresh->light;
+	fresh->light = lights;
+	lights = data->light_last;
+	data->light_last = fresh->light_last;
+	fresh->light_last = lights;
+	arena = data->light_arena;
+	data->light_arena = fresh->light_arena;
+	fresh->light_arena = arena;
+}
+
+static void	swap_objects(t_data *data, t_data *fresh)
+{
+	t_object	*objects;
+	t_arena		arena;
+
+	objects = data->object;
+	data->object = fresh->object;
+	fresh->object = objects;
+	objects = data->object_last;
+	data->object_last = fresh->object_last;
+	fresh->object_last = objects;
+	arena = data->arena;
+	data->arena = fresh->arena;
+	fresh->arena = arena;
+}
+
+/*
+** Moves what changed into the live scene and the old copies into `fresh`,
+** which the caller frees: only the materials that differ, and the lights
+** only when they differ. Objects stay put, so G-buffer records keep
+** pointing at them. The light tree is rebuilt with the lights; occluder
+** lists only when a light or a shadow flag changed.
+*/
+static void	take_shading(t_data *data, t_data *fresh, t_scene_diff *diff)
+{
+	t_object	*a;
+	t_object	*b;
+	t_material	swap;
+
+	a = data->object;
+	b = fresh->object;
+	while (a && diff->materials > 0)
+	{
+		if (!same_material(object_material(a), object_material(b)))
+		{
+			swap = *object_material(a);
+			*object_material(a) = *object_material(b);
+			*object_material(b) = swap;
+		}
+		a = a->next;
+		b = b->next;
+	}
+	if (diff->lights)
+	{
+		swap_lights(data, fresh);
+		data->world.lights = data->light;
+		data->world.light_tree = NULL;
+		if (build_light_tree(&data->light_tree, data->light,
+				data->world.trace.light_cutoff))
+			data->world.light_tree = &data->light_tree;
+	}
+	data->ambl = fresh->ambl;
+	data->world.ambient_color = data->ambl.color;
+	if (diff->lights || diff->shadows)
+		build_light_occluders(&data->world,
+			ray_for_pixel(data->cam, 0, 0).origin);
+}
+
+static void	take_scene(t_data *data, t_data *fresh)
+{
+	t_instances	instances;
+	t_anim		anim;
+	t_camera	cam;
+
+	swap_objects(data, fresh);
+	instances = data->instances;
+	data->instances = fresh->instances;
+	fresh->instances = instances;
+	swap_lights(data, fresh);
+	anim = data->anim;
+	data->anim = fresh->anim;
+	fresh->anim = anim;
+	data->ambl = fresh->ambl;
+	data->cam = fresh->cam;
+	setup_world(data, &cam);
+}
+
+static void	report_diff(t_scene_diff *diff)
+{
+	printf("🔄 Scene changed:");
+	if (diff->view)
+		printf(" camera");
+	if (diff->geometry)
+		printf(" geometry");
+	if (diff->materials > 0)
+		printf(" %d material(s)", diff->materials);
+	if (diff->lights)
+		printf(" lights");
+	if (diff->ambient)
+		printf(" ambient");
+	printf("\n");
+}
+
+/*
+** Applies a parsed copy of the scene file to the live one. When only
+** shading changed and the G-buffer holds a finished frame, the frame is
+** relit from the stored first hits; anything else is a full re-render.
+*/
+static bool	apply_reload(t_data *data, t_data *fresh, t_scene_diff *diff)
+{
+	bool	relight;
+
+	report_diff(diff);
+	if (data->state == STATE_RENDERING)
+		stop_threaded_render(data);
+	relight = gbuffer_usable(data) && !diff->view && !diff->geometry
+		&& !diff->surfaces;
+	if (diff->view || diff->geometry || diff->surfaces)
+		data->gbuf.valid = false;
+	if (diff->view || diff->geometry)
+		take_scene(data, fresh);
+	else
+		take_shading(data, fresh, diff);
+	data->opts.job.region = (t_tile){0, 0, 0, 0};
+	data->relight = relight;
+	if (!restart_render(data))
+		return (false);
+	if (relight)
+		printf("💡 Relighting from the G-buffer\n");
+	return (true);
+}
+
+/*
+** R in the window, or a save picked up by the scene watcher: parses the
+** scene file again, reusing decoded textures, and applies only what
+** changed. A file that no longer parses, or did not change, leaves the
+** current scene and any render in progress alone.
+*/
+bool	reload_scene(t_data *data)
+{
+	t_data			fresh;
+	t_scene_diff	diff;
+	bool			ok;
+
+	fresh = (t_data){};
+	fresh.textures = data->textures;
+	if (!complete_parsing(data->opts.scene, &fresh))
+		return (printf("❌ Reload failed, keeping the current scene\n"),
+			false);
+	diff_scene(data, &fresh, &diff);
+	ok = true;
+	if (diff.view || diff.geometry || diff.materials > 0 || diff.lights
+		|| diff.ambient)
+		ok = apply_reload(data, &fresh, &diff);
+	else
+		printf("✔️  Scene unchanged\n");
+	free_objects_and_lights(&fresh);
+	return (ok);
+}
@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 07:16:17 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 20:43:21 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -19,89 +19,285 @@ uint32_t	tuple_to_pixel(t_tuple color)
 	uint8_t		b;
 	uint32_t	pixel_color;
 
-	r = (uint8_t)(fmin(fmax(color.x, 0.0), 1.0) * 255);
-	g = (uint8_t)(fmin(fmax(color.y, 0.0), 1.0) * 255);
-	b = (uint8_t)(fmin(fmax(color.z, 0.0), 1.0) * 255);
+	r = channel_to_byte(color.x);
+	g = channel_to_byte(color.y);
+	b = channel_to_byte(color.z);
 	pixel_color = (r << 24) | (g << 16) | (b << 8) | 0xFF;
 	return (pixel_color);
 }
 
-static void	render_line(t_render_ctx *ctx, int y)
+/*
+** Averages `samples` rays through pixel (x, y). Offsets follow the R2
+** low-discrepancy sequence seeded at the pixel centre, so one sample is
+** exactly the old centre ray and more samples fill the pixel evenly.
+*/
+t_tuple	trace_pixel(t_world world, t_camera cam, int x, int y, int samples)
 {
-	int			x;
-	t_ray		ray;
+	t_tuple	sum;
+	double	u;
+	double	v;
+	int		i;
+
+	if (samples <= 1)
+		return (color_at(world, ray_for_pixel(cam, (double)x, (double)y),
+				MAX_REFLECTION_DEPTH, 1.0f));
+	sum = (t_tuple){0, 0, 0, 0};
+	i = 0;
+	while (i < samples)
+	{
+		u = fmod(0.5 + i * R2_ALPHA_X, 1.0) - 0.5;
+		v = fmod(0.5 + i * R2_ALPHA_Y, 1.0) - 0.5;
+		sum = add_tuple(sum, color_at(world, ray_for_pixel(cam, x + u,
+						y + v), MAX_REFLECTION_DEPTH, 1.0f));
+		i++;
+	}
+	return (tuple_scalar_divide(sum, (float)samples));
+}
+
+/*
+** Next tile index nobody has taken, skipping tiles restored from a
+** checkpoint; -1 once the frame is handed out.
+*/
+static int	next_tile(t_render_ctx *ctx)
+{
+	int	index;
+
+	pthread_mutex_lock(ctx->mutex);
+	while (*ctx->next_tile < ctx->total_tiles
+		&& ctx->tile_done[*ctx->next_tile])
+		(*ctx->next_tile)++;
+	index = (*ctx->next_tile)++;
+	pthread_mutex_unlock(ctx->mutex);
+	if (index >= ctx->total_tiles)
+		return (-1);
+	return (index);
+}
+
+/*
+** A relight pass shades from the G-buffer; with --gbuffer a full pass
+** fills it; otherwise pixels are traced as usual.
+*/
+static t_tuple	render_pixel(t_render_ctx *ctx, int x, int y)
+{
+	int	xy[2];
+
+	if (ctx->relight)
+		return (relight_pixel(ctx->gbuf, ctx->world, x, y));
+	if (ctx->gbuf)
+	{
+		xy[0] = x;
+		xy[1] = y;
+		return (trace_gbuffer_pixel(ctx->gbuf, ctx->world, ctx->cam, xy));
+	}
+	return (trace_pixel(ctx->world, ctx->cam, x, y, ctx->samples));
+}
+
+/*
+** --heatmap: the same pixel with its CPU time and ray counts recorded.
+*/
+static t_tuple	measure_pixel(t_render_ctx *ctx, int x, int y)
+{
+	t_ray_stats	stats;
+	double		start;
 	t_tuple		color;
-	uint32_t	pixel_color;
 
-	x = 0;
-	while (x < (int)ctx->cam.h_view)
+	stats = (t_ray_stats){0};
+	ctx->world.stats = &stats;
+	start = heat_clock();
+	color = render_pixel(ctx, x, y);
+	stats.seconds = heat_clock() - start;
+	ctx->world.stats = NULL;
+	heatmap_record(ctx->heat, x, y, &stats);
+	return (color);
+}
+
+/*
+** While the tile is traced, world.primary narrows from the frame's visible
+** set to the objects the tile's own frustum meets.
+*/
+static bool	render_tile(t_render_ctx *ctx, t_tile tile)
+{
+	t_object	**frame;
+	int			x;
+	int			y;
+
+	frame = ctx->world.primary;
+	if (!ctx->relight)
+		ctx->world.primary = frustum_objects(&ctx->world, ctx->cam, tile);
+	y = tile.y;
+	while (y < tile.y + tile.h && !*(ctx->stop_flag))
 	{
-		if (*(ctx->stop_flag))
-			return ;
-		ray = ray_for_pixel(ctx->cam, (double)x, (double)y);
-		color = color_at(ctx->world, ray, MAX_REFLECTION_DEPTH);
-		pixel_color = tuple_to_pixel(color);
-		mlx_put_pixel(ctx->img, x, y, pixel_color);
-		x++;
+		x = tile.x;
+		while (x < tile.x + tile.w)
+		{
+			if (ctx->heat)
+				framebuffer_store(ctx->fb, x, y, measure_pixel(ctx, x, y));
+			else
+				framebuffer_store(ctx->fb, x, y, render_pixel(ctx, x, y));
+			x++;
+		}
+		y++;
 	}
+	if (ctx->world.primary != frame)
+		free(ctx->world.primary);
+	ctx->world.primary = frame;
+	if (y < tile.y + tile.h)
+		return (false);
+	framebuffer_resolve(ctx->fb, ctx->img, tile);
+	return (true);
 }
 
+/*
+** Workers pull TILE_SIZE tiles of the render region off a shared counter
+** until none are left, so a slow area no longer holds up one thread's
+** whole band. Each tile
+** is traced into the float framebuffer, then resolved into the image.
+*/
 void	*render_thread_func(void *arg)
 {
 	t_render_ctx	*ctx;
-	int				y;
+	int				index;
+	uint64_t		start;
 
 	ctx = (t_render_ctx *)arg;
-	y = ctx->start_y;
-	while (y < ctx->end_y)
+	prof_thread("render");
+	while (!*(ctx->stop_flag))
 	{
-		if (*(ctx->stop_flag))
+		index = next_tile(ctx);
+		start = prof_now();
+		if (index < 0 || !render_tile(ctx, region_tile(ctx->region, index)))
 			break ;
-		render_line(ctx, y);
+		prof_span("tile", start, index);
 		pthread_mutex_lock(ctx->mutex);
-		(*(ctx->lines_done))++;
+		ctx->tile_done[index] = 1;
+		(*(ctx->tiles_done))++;
 		pthread_mutex_unlock(ctx->mutex);
-		y++;
 	}
 	return (NULL);
 }
 
-void	start_threaded_render(t_data *data)
+/*
+** Sizes the tile bookkeeping for the render region, culls the scene to the
+** region's view frustum (tiles cull further from that) and, with
+** --checkpoint, sets up the key, restores a matching checkpoint on --resume
+** (showing its tiles right away) and starts the periodic writer.
+*/
+static bool	prepare_tiles(t_data *data)
+{
+	int	i;
+
+	data->tiles_done = 0;
+	data->next_tile = 0;
+	data->total_tiles = region_tile_count(data->region);
+	free(data->tile_done);
+	data->tile_done = ft_calloc(data->total_tiles, 1);
+	if (!data->tile_done)
+		return (printf("❌ Error: cannot allocate tile list\n"), false);
+	free(data->visible);
+	data->visible = frustum_objects(&data->world, data->cam, data->region);
+	if (!data->opts.checkpoint)
+		return (true);
+	if (!checkpoint_key(data, &data->ckpt.key))
+		return (printf("❌ Error: cannot fingerprint %s\n",
+				data->opts.scene), false);
+	if (data->opts.resume)
+		checkpoint_load(data);
+	i = 0;
+	while (data->img && i < data->total_tiles)
+	{
+		if (data->tile_done[i])
+			framebuffer_resolve(&data->fb, data->img,
+				region_tile(data->region, i));
+		i++;
+	}
+	if (!checkpoint_start(data))
+		return (printf("❌ Error: cannot start checkpoint writer\n"), false);
+	return (true);
+}
+
+/*
+** Traces opts.job.region (the whole frame when empty). The framebuffer
+** and image are kept between renders, so everything outside the region
+** still shows the previous frame. data->relight asks for one relight pass
+** from the G-buffer instead and is cleared once the threads have it; a
+** full-frame pass with --gbuffer refills it.
+*/
+bool	start_threaded_render(t_data *data)
 {
 	int		i;
-	int		lines_per_thread;
-	int		start_y;
 
-	data->lines_done = 0;
-	data->total_lines = (int)data->cam.v_view;
+	if (!data->fb.rgb && !framebuffer_init(&data->fb, (int)data->cam.h_view,
+			(int)data->cam.v_view))
+		return (printf("❌ Error: cannot allocate framebuffer\n"), false);
+	if (data->opts.gbuffer && !gbuffer_prepare(&data->gbuf, data->cam))
+		return (printf("❌ Error: cannot allocate G-buffer\n"), false);
+	if (data->opts.heatmap && !heatmap_prepare(&data->heat, data->fb.width,
+			data->fb.height))
+		return (printf("❌ Error: cannot allocate heatmap\n"), false);
+	if (!job_region(&data->opts.job, &data->region))
+		return (printf("❌ Error: render region outside the frame\n"), false);
+	gbuffer_usable(data);
+	data->gbuf.filling = data->opts.gbuffer && !data->relight
+		&& data->region.w == data->fb.width
+		&& data->region.h == data->fb.height;
 	data->stop_flag = 0;
 	data->render_complete = false;
 	data->threads_started = false;
 	data->mutex_initialized = false;
 	pthread_mutex_init(&data->render_mutex, NULL);
 	data->mutex_initialized = true;
-	lines_per_thread = data->total_lines / NUM_THREADS;
-	start_y = 0;
+	if (!prepare_tiles(data))
+		return (stop_threaded_render(data), false);
 	i = 0;
 	while (i < NUM_THREADS)
 	{
 		data->thread_ctx[i].img = data->img;
+		data->thread_ctx[i].fb = &data->fb;
 		data->thread_ctx[i].cam = data->cam;
 		data->thread_ctx[i].world = data->world;
-		data->thread_ctx[i].start_y = start_y;
-		if (i == NUM_THREADS - 1)
-			data->thread_ctx[i].end_y = data->total_lines;
-		else
-			data->thread_ctx[i].end_y = start_y + lines_per_thread;
-		data->thread_ctx[i].lines_done = &data->lines_done;
+		data->thread_ctx[i].world.primary = data->visible;
+		data->thread_ctx[i].samples = data->opts.job.samples;
+		data->thread_ctx[i].gbuf = NULL;
+		if (data->opts.gbuffer)
+			data->thread_ctx[i].gbuf = &data->gbuf;
+		data->thread_ctx[i].relight = data->relight;
+		data->thread_ctx[i].heat = NULL;
+		if (data->opts.heatmap)
+			data->thread_ctx[i].heat = &data->heat;
+		data->thread_ctx[i].region = data->region;
+		data->thread_ctx[i].total_tiles = data->total_tiles;
+		data->thread_ctx[i].tile_done = data->tile_done;
+		data->thread_ctx[i].next_tile = &data->next_tile;
+		data->thread_ctx[i].tiles_done = &data->tiles_done;
 		data->thread_ctx[i].mutex = &data->render_mutex;
 		data->thread_ctx[i].stop_flag = &data->stop_flag;
 		pthread_create(&data->threads[i], NULL, render_thread_func,
 			&data->thread_ctx[i]);
-		start_y += lines_per_thread;
 		i++;
 	}
 	data->threads_started = true;
+	data->relight = false;
+	return (true);
+}
+
+/*
+** Starts another render from the window (a drag or a reload). The window
+** is live from then on, so a load-mode window shows the image and
+** switches to preview. These quick iterations are not checkpointed, which
+** leaves the full frame's checkpoint alone.
+*/
+bool	restart_render(t_data *data)
+{
+	data->opts.checkpoint = NULL;
+	data->opts.resume = false;
+	data->render_mode = MODE_PREVIEW;
+	show_rendered_image(data);
+	data->state = STATE_RENDERING;
+	if (start_threaded_render(data))
+		return (true);
+	data->relight = false;
+	data->state = STATE_DISPLAY;
+	return (false);
 }
 
 void	stop_threaded_render(t_data *data)
@@ -119,38 +315,10 @@ void	stop_threaded_render(t_data *data)
 		}
 		data->threads_started = false;
 	}
+	checkpoint_stop(data);
 	if (data->mutex_initialized)
 	{
 		pthread_mutex_destroy(&data->render_mutex);
 		data->mutex_initialized = false;
 	}
 }
-
-mlx_image_t	*render(mlx_t *mlx, t_camera cam, t_world world)
-{
-	mlx_image_t	*img;
-	int			x;
-	int			y;
-	t_ray		ray;
-	t_tuple		color;
-
-	if (!mlx)
-		return (NULL);
-	img = mlx_new_image(mlx, (int)cam.h_view, (int)cam.v_view);
-	if (!img)
-		return (NULL);
-	y = 0;
-	while (y < (int)cam.v_view)
-	{
-		x = 0;
-		while (x < (int)cam.h_view)
-		{
-			ray = ray_for_pixel(cam, (double)x, (double)y);
-			color = color_at(world, ray, MAX_REFLECTION_DEPTH);
-			mlx_put_pixel(img, x, y, tuple_to_pixel(color));
-			x++;
-		}
-		y++;
-	}
-	return (img);
-}
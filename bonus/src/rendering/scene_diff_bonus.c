@@ -0,0 +1,235 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   scene_diff_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 22:06:37 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 22:31:36 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+#include "../MLX42/include/MLX42/MLX42.h"
+
+/*
+** Exact comparisons: compare_matrix and tuple_comparison allow EPSILON,
+** which is too loose to decide whether cached hits are still valid.
+*/
+static bool	same_tuple(t_tuple a, t_tuple b)
+{
+	return (a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w);
+}
+
+static bool	same_matrix(t_matrix a, t_matrix b)
+{
+	return (ft_memcmp(a.mtrx, b.mtrx, sizeof(a.mtrx)) == 0);
+}
+
+static bool	same_texture(mlx_texture_t *a, mlx_texture_t *b)
+{
+	if (a == b)
+		return (true);
+	if (!a || !b)
+		return (a == b);
+	return (a->width == b->width && a->height == b->height
+		&& a->bytes_per_pixel == b->bytes_per_pixel
+		&& ft_memcmp(a->pixels, b->pixels, (size_t)a->width * a->height
+			* a->bytes_per_pixel) == 0);
+}
+
+/*
+** Material settings that feed a G-buffer record rather than shading: the
+** perturbed normal, the UV, and n1/n2 (set only for transparent hits).
+*/
+static bool	same_surface(t_material *a, t_material *b)
+{
+	return (a->has_bump_map == b->has_bump_map
+		&& a->has_normal_map == b->has_normal_map
+		&& a->has_color_texture == b->has_color_texture
+		&& a->bump_strength == b->bump_strength
+		&& a->refract_index == b->refract_index
+		&& (a->transparency > 0.0f) == (b->transparency > 0.0f)
+		&& same_texture(a->bump_map, b->bump_map)
+		&& same_texture(a->normal_map, b->normal_map));
+}
+
+/*
+** A reparse loads the OBJ again, so the geometry is the same when it
+** comes from the same file, unmodified since.
+*/
+static bool	same_mesh(t_mesh_data *a, t_mesh_data *b)
+{
+	return (a->tri_count == b->tri_count
+		&& a->mtime.tv_sec == b->mtime.tv_sec
+		&& a->mtime.tv_nsec == b->mtime.tv_nsec
+		&& ft_strncmp(a->path, b->path, ft_strlen(a->path) + 1) == 0);
+}
+
+/*
+** The hit set of an object is fixed by its transform plus the fields the
+** intersection and normal code read directly.
+*/
+static bool	same_shape(t_object *a, t_object *b)
+{
+	t_shapes	*s;
+	t_shapes	*t;
+
+	s = &a->shape;
+	t = &b->shape;
+	if (a->type != b->type)
+		return (false);
+	if (a->type == OBJ_SPHERE)
+		return (same_tuple(s->sp.center, t->sp.center)
+			&& s->sp.diam == t->sp.diam
+			&& same_matrix(s->sp.trans, t->sp.trans));
+	if (a->type == OBJ_PLANE)
+		return (same_tuple(s->pl.point, t->pl.point)
+			&& same_tuple(s->pl.normal, t->pl.normal)
+			&& same_matrix(s->pl.trans, t->pl.trans));
+	if (a->type == OBJ_CYLINDER)
+		return (same_matrix(s->cy.trans, t->cy.trans)
+			&& s->cy.minimum == t->cy.minimum
+			&& s->cy.maximum == t->cy.maximum && s->cy.closed == t->cy.closed
+			&& s->cy.diameter == t->cy.diameter);
+	if (a->type == OBJ_MESH)
+		return (same_mesh(s->me.geo, t->me.geo)
+			&& same_matrix(s->me.trans, t->me.trans));
+	return (same_matrix(s->co.trans, t->co.trans)
+		&& s->co.minimum == t->co.minimum && s->co.maximum == t->co.maximum
+		&& s->co.closed == t->co.closed && s->co.angle == t->co.angle
+		&& s->co.diameter == t->co.diameter);
+}
+
+/*
+** Everything shade_surface and the bounce code read from a material.
+** Textures come from the cache, so an unchanged file is the same pointer
+** and same_texture rarely has to compare pixels. A pattern transform is
+** left unset unless has_transform is.
+*/
+bool	same_material(t_material *a, t_material *b)
+{
+	return (same_tuple(a->color, b->color) && a->ambient == b->ambient
+		&& a->diffuse == b->diffuse && a->specular == b->specular
+		&& a->shininess == b->shininess && a->reflective == b->reflective
+		&& a->transparency == b->transparency
+		&& a->refract_index == b->refract_index
+		&& a->pattern.at == b->pattern.at
+		&& same_tuple(a->pattern.a, b->pattern.a)
+		&& same_tuple(a->pattern.b, b->pattern.b)
+		&& a->pattern.has_transform == b->pattern.has_transform
+		&& (!a->pattern.has_transform
+			|| same_matrix(a->pattern.transform, b->pattern.transform))
+		&& same_texture(a->color_texture, b->color_texture)
+		&& a->casts_shadow == b->casts_shadow
+		&& a->receives_shadow == b->receives_shadow
+		&& same_surface(a, b));
+}
+
+static bool	same_lights(t_light *a, t_light *b)
+{
+	while (a && b)
+	{
+		if (!same_tuple(a->origin, b->origin)
+			|| !same_tuple(a->color, b->color)
+			|| a->brightness != b->brightness
+			|| a->range != b->range || a->kind != b->kind
+			|| !same_tuple(a->u, b->u) || !same_tuple(a->v, b->v)
+			|| a->radius != b->radius)
+			return (false);
+		a = a->next;
+		b = b->next;
+	}
+	return (a == NULL && b == NULL);
+}
+
+static void	diff_objects(t_object *a, t_object *b, t_scene_diff *diff)
+{
+	t_material	*ma;
+	t_material	*mb;
+
+	while (a && b)
+	{
+		ma = object_material(a);
+		mb = object_material(b);
+		if (!same_shape(a, b))
+			diff->geometry = true;
+		else if (!same_material(ma, mb))
+		{
+			diff->materials++;
+			if (!same_surface(ma, mb))
+				diff->surfaces = true;
+			if (ma->casts_shadow != mb->casts_shadow)
+				diff->shadows = true;
+		}
+		a = a->next;
+		b = b->next;
+	}
+	if (a || b)
+		diff->geometry = true;
+}
+
+static bool	same_members(t_object *a, t_object *b)
+{
+	while (a && b)
+	{
+		if (!same_shape(a, b)
+			|| !same_material(object_material(a), object_material(b)))
+			return (false);
+		a = a->next;
+		b = b->next;
+	}
+	return (a == NULL && b == NULL);
+}
+
+/*
+** Instanced geometry is compared as a whole: any change to a prototype or
+** an instance counts as a geometry change.
+*/
+static bool	same_instances(t_instances *a, t_instances *b)
+{
+	t_proto	*pa;
+	t_proto	*pb;
+	int		i;
+
+	pa = a->protos;
+	pb = b->protos;
+	while (pa && pb)
+	{
+		if (ft_strncmp(pa->name, pb->name, ft_strlen(pa->name) + 1) != 0
+			|| !same_members(pa->members, pb->members))
+			return (false);
+		pa = pa->next;
+		pb = pb->next;
+	}
+	if (pa || pb || a->count != b->count)
+		return (false);
+	i = -1;
+	while (++i < a->count)
+		if (ft_strncmp(a->items[i].proto->name, b->items[i].proto->name,
+				ft_strlen(a->items[i].proto->name) + 1) != 0
+			|| !same_matrix(a->items[i].trans_inv, b->items[i].trans_inv))
+			return (false);
+	return (true);
+}
+
+/*
+** What a reparse changed, object by object in file order. view, geometry
+** and surfaces make G-buffer records stale; materials, lights and ambient
+** only change shading.
+*/
+void	diff_scene(t_data *data, t_data *fresh, t_scene_diff *diff)
+{
+	ft_bzero(diff, sizeof(*diff));
+	diff->view = !data->opts.job.has_camera
+		&& (fresh->cam.fov * M_PI / 180.0 != data->cam.fov
+			|| !same_matrix(view_transformation(fresh->cam.from,
+					fresh->cam.to, fresh->cam.up), data->cam.transform));
+	diff_objects(data->object, fresh->object, diff);
+	if (!same_instances(&data->instances, &fresh->instances))
+		diff->geometry = true;
+	diff->lights = !same_lights(data->light, fresh->light);
+	diff->ambient = data->ambl.l_ratio != fresh->ambl.l_ratio
+		|| !same_tuple(data->ambl.color, fresh->ambl.color);
+}
@@ -0,0 +1,89 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   scene_watch_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 22:13:50 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 22:13:50 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+#include <sys/inotify.h>
+
+static char	*scene_name(char *path)
+{
+	char	*slash;
+
+	slash = ft_strrchr(path, '/');
+	if (slash)
+		return (slash + 1);
+	return (path);
+}
+
+/*
+** Watches the scene's directory rather than the file: most editors save
+** by writing a new file and renaming it over the old one, which would
+** silently end a watch on the file itself.
+*/
+bool	watch_start(t_data *data)
+{
+	char	*dir;
+	size_t	len;
+
+	len = scene_name(data->opts.scene) - data->opts.scene;
+	if (len > 1)
+		len--;
+	if (len == 0)
+		dir = ft_strdup(".");
+	else
+		dir = ft_substr(data->opts.scene, 0, len);
+	if (!dir)
+		return (false);
+	data->watch_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (data->watch_fd >= 0 && inotify_add_watch(data->watch_fd, dir,
+			IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+		watch_stop(data);
+	free(dir);
+	return (data->watch_fd >= 0);
+}
+
+/*
+** Drains every pending event without blocking and reports whether one of
+** them was the scene file being written or moved into place, so a burst
+** of events from one save triggers a single reload.
+*/
+bool	watch_poll(t_data *data)
+{
+	struct inotify_event	buf[WATCH_EVENTS];
+	struct inotify_event	*event;
+	ssize_t					len;
+	ssize_t					i;
+	bool					changed;
+
+	changed = false;
+	len = read(data->watch_fd, buf, sizeof(buf));
+	while (len > 0)
+	{
+		i = 0;
+		while (i < len)
+		{
+			event = (struct inotify_event *)((char *)buf + i);
+			if (event->len > 0 && ft_strncmp(event->name,
+					scene_name(data->opts.scene), event->len) == 0)
+				changed = true;
+			i += sizeof(struct inotify_event) + event->len;
+		}
+		len = read(data->watch_fd, buf, sizeof(buf));
+	}
+	return (changed);
+}
+
+void	watch_stop(t_data *data)
+{
+	if (data->watch_fd >= 0)
+		close(data->watch_fd);
+	data->watch_fd = -1;
+}
@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2026/01/03 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 07:16:17 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 13:55:53 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -131,11 +131,11 @@ void	update_progress_bar(t_data *data)
 	int			y;
 	uint32_t	color;
 
-	if (!data->bar_fill || data->total_lines == 0)
+	if (!data->bar_fill || data->total_tiles == 0)
 		return ;
 	bar_w = 596;
 	bar_h = 26;
-	progress = (float)data->lines_done / (float)data->total_lines;
+	progress = (float)data->tiles_done / (float)data->total_tiles;
 	if (progress > 1.0f)
 		progress = 1.0f;
 	fill_width = (int)(bar_w * progress);
@@ -154,7 +154,7 @@ void	update_progress_bar(t_data *data)
 		}
 		y++;
 	}
-	if (data->lines_done >= data->total_lines && !data->render_complete)
+	if (data->tiles_done >= data->total_tiles && !data->render_complete)
 	{
 		data->render_complete = true;
 		data->state = STATE_WAITING;
@@ -0,0 +1,127 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_bonus.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 16:13:00 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 03:38:35 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+static bool	send_request(int fd, t_options *opts)
+{
+	char		*path;
+	uint32_t	len;
+	bool		ok;
+
+	path = realpath(opts->scene, NULL);
+	if (!path)
+		path = ft_strdup(opts->scene);
+	if (!path)
+		return (false);
+	len = ft_strlen(path);
+	ok = net_send(fd, MSG_RENDER, NULL, sizeof(t_job) + len)
+		&& net_write(fd, &opts->job, sizeof(t_job))
+		&& net_write(fd, path, len);
+	free(path);
+	return (ok);
+}
+
+static bool	receive_tile(int fd, t_job *job, uint8_t *image, uint32_t size)
+{
+	static uint8_t	rgb[TILE_SIZE * TILE_SIZE * 3];
+	t_tile			tile;
+	int				y;
+
+	if (size < sizeof(tile) || !net_read(fd, &tile, sizeof(tile))
+		|| tile.w <= 0 || tile.h <= 0 || tile.w > TILE_SIZE
+		|| tile.h > TILE_SIZE || tile.x < 0 || tile.y < 0
+		|| tile.x + tile.w > job->width || tile.y + tile.h > job->height
+		|| size != sizeof(tile) + (uint32_t)tile.w * tile.h * 3
+		|| !net_read(fd, rgb, size - sizeof(tile)))
+		return (false);
+	y = -1;
+	while (++y < tile.h)
+		ft_memcpy(&image[((size_t)(tile.y + y) * job->width + tile.x) * 3],
+			&rgb[y * tile.w * 3], tile.w * 3);
+	return (true);
+}
+
+static bool	write_rgb_ppm(char *path, uint8_t *image, int width, int height)
+{
+	FILE	*output;
+	size_t	bytes;
+
+	output = fopen(path, "wb");
+	if (!output)
+		return (printf("❌ Error: cannot write %s\n", path), false);
+	fprintf(output, "P6\n%d %d\n255\n", width, height);
+	bytes = (size_t)width * height * 3;
+	if (fwrite(image, 1, bytes, output) != bytes)
+		return (fclose(output), false);
+	printf("💾 Saved %s\n", path);
+	return (fclose(output) == 0);
+}
+
+static bool	receive_frame(int fd, t_job *job, uint8_t *image)
+{
+	t_msg_header	header;
+	t_render_stats	stats;
+
+	while (net_read(fd, &header, sizeof(header)))
+	{
+		if (header.type == MSG_RESULT)
+		{
+			if (!receive_tile(fd, job, image, header.size))
+				break ;
+		}
+		else if (header.type == MSG_DONE && header.size == sizeof(stats)
+			&& net_read(fd, &stats, sizeof(stats)))
+		{
+			if (stats.cache_hit)
+				printf("✅ %d tiles, scene cached: ", stats.tiles);
+			else
+				printf("✅ %d tiles, scene parsed: ", stats.tiles);
+			printf("load %.1f ms, render %.1f ms\n", stats.load_ms,
+				stats.render_ms);
+			return (true);
+		}
+		else
+			break ;
+	}
+	return (printf("❌ Error: the render server rejected the job\n"), false);
+}
+
+/*
+** `--connect <addr>`: have a render server trace the scene with this
+** command line's settings and save the streamed tiles to --output.
+*/
+int	run_client(t_options *opts)
+{
+	uint8_t		*image;
+	char		*output;
+	int			fd;
+	bool		ok;
+	uint64_t	start;
+
+	fd = net_connect(opts->connect);
+	if (fd < 0)
+		return (1);
+	image = ft_calloc((size_t)opts->job.width * opts->job.height, 3);
+	ok = image && send_request(fd, opts)
+		&& receive_frame(fd, &opts->job, image);
+	close(fd);
+	output = opts->output;
+	if (!output)
+		output = "render.ppm";
+	start = prof_now();
+	ok = ok && write_rgb_ppm(output, image, opts->job.width,
+			opts->job.height);
+	prof_span("export", start, -1);
+	free(image);
+	return (!ok);
+}
@@ -0,0 +1,76 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   render_jobs_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 15:58:34 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 15:58:34 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+/*
+** Queues every tile of `region` (already clipped to the frame) for the
+** pool's threads. Only called while the pool is idle, so the job fields
+** can be swapped without racing a worker.
+*/
+bool	pool_submit(t_render_pool *pool, t_data *data, t_tile region)
+{
+	int	total;
+
+	pool->tiles_x = (region.w + TILE_SIZE - 1) / TILE_SIZE;
+	total = pool->tiles_x * ((region.h + TILE_SIZE - 1) / TILE_SIZE);
+	if (pool->fb.width != region.w || pool->fb.height != region.h)
+	{
+		framebuffer_free(&pool->fb);
+		if (!framebuffer_init(&pool->fb, region.w, region.h))
+			return (false);
+	}
+	free(pool->finished);
+	pool->finished = malloc(sizeof(int) * total);
+	if (!pool->finished)
+		return (false);
+	pthread_mutex_lock(&pool->mutex);
+	pool->world = data->world;
+	pool->cam = data->cam;
+	pool->region = region;
+	pool->samples = data->opts.job.samples;
+	pool->finished_count = 0;
+	pool->next_tile = 0;
+	pool->total_tiles = total;
+	pthread_cond_broadcast(&pool->work);
+	pthread_mutex_unlock(&pool->mutex);
+	return (true);
+}
+
+/*
+** Blocks until more than `seen` tiles have finished and returns how many
+** have; pool->finished[seen..n) are then safe to read from pool->fb.
+*/
+int	pool_collect(t_render_pool *pool, int seen)
+{
+	int	count;
+
+	pthread_mutex_lock(&pool->mutex);
+	while (pool->finished_count <= seen && seen < pool->total_tiles)
+		pthread_cond_wait(&pool->done, &pool->mutex);
+	count = pool->finished_count;
+	pthread_mutex_unlock(&pool->mutex);
+	return (count);
+}
+
+/*
+** Stops handing out tiles and waits for the ones in flight, leaving the
+** pool idle (e.g. when the client hung up mid-stream).
+*/
+void	pool_cancel(t_render_pool *pool)
+{
+	pthread_mutex_lock(&pool->mutex);
+	pool->total_tiles = pool->next_tile;
+	while (pool->running > 0)
+		pthread_cond_wait(&pool->done, &pool->mutex);
+	pthread_mutex_unlock(&pool->mutex);
+}
@@ -0,0 +1,110 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   render_pool_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 15:51:21 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 20:50:34 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+/*
+** Primary rays only test the objects the tile's view frustum meets.
+*/
+static void	render_pool_tile(t_render_pool *pool, int index)
+{
+	t_tile	tile;
+	t_world	world;
+	int		x;
+	int		y;
+
+	tile = tile_rect(index, pool->tiles_x, pool->region.w, pool->region.h);
+	world = pool->world;
+	world.primary = frustum_objects(&pool->world, pool->cam, (t_tile){
+			pool->region.x + tile.x, pool->region.y + tile.y, tile.w, tile.h});
+	y = tile.y;
+	while (y < tile.y + tile.h)
+	{
+		x = tile.x;
+		while (x < tile.x + tile.w)
+		{
+			framebuffer_store(&pool->fb, x, y, trace_pixel(world,
+					pool->cam, pool->region.x + x, pool->region.y + y,
+					pool->samples));
+			x++;
+		}
+		y++;
+	}
+	free(world.primary);
+}
+
+static void	*pool_thread(void *arg)
+{
+	t_render_pool	*pool;
+	int				index;
+	uint64_t		start;
+
+	pool = (t_render_pool *)arg;
+	prof_thread("pool");
+	pthread_mutex_lock(&pool->mutex);
+	while (!pool->quit)
+	{
+		if (pool->next_tile >= pool->total_tiles)
+		{
+			pthread_cond_wait(&pool->work, &pool->mutex);
+			continue ;
+		}
+		index = pool->next_tile++;
+		pool->running++;
+		pthread_mutex_unlock(&pool->mutex);
+		start = prof_now();
+		render_pool_tile(pool, index);
+		prof_span("tile", start, index);
+		pthread_mutex_lock(&pool->mutex);
+		pool->running--;
+		pool->finished[pool->finished_count++] = index;
+		pthread_cond_broadcast(&pool->done);
+	}
+	pthread_mutex_unlock(&pool->mutex);
+	return (NULL);
+}
+
+bool	pool_start(t_render_pool *pool, int thread_count)
+{
+	*pool = (t_render_pool){};
+	pool->threads = ft_calloc(thread_count, sizeof(pthread_t));
+	if (!pool->threads)
+		return (false);
+	pthread_mutex_init(&pool->mutex, NULL);
+	pthread_cond_init(&pool->work, NULL);
+	pthread_cond_init(&pool->done, NULL);
+	while (pool->thread_count < thread_count)
+	{
+		if (pthread_create(&pool->threads[pool->thread_count], NULL,
+				pool_thread, pool) != 0)
+			break ;
+		pool->thread_count++;
+	}
+	return (pool->thread_count > 0);
+}
+
+void	pool_stop(t_render_pool *pool)
+{
+	pool_cancel(pool);
+	pthread_mutex_lock(&pool->mutex);
+	pool->quit = true;
+	pthread_cond_broadcast(&pool->work);
+	pthread_mutex_unlock(&pool->mutex);
+	while (pool->thread_count > 0)
+		pthread_join(pool->threads[--pool->thread_count], NULL);
+	pthread_cond_destroy(&pool->done);
+	pthread_cond_destroy(&pool->work);
+	pthread_mutex_destroy(&pool->mutex);
+	framebuffer_free(&pool->fb);
+	free(pool->finished);
+	free(pool->threads);
+}
@@ -0,0 +1,113 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   scene_cache_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 15:44:08 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 18:58:59 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+
+static void	free_entry(t_scene_entry *entry)
+{
+	if (entry->data)
+		free_objects_and_lights(entry->data);
+	free(entry->data);
+	free(entry->path);
+	free(entry);
+}
+
+static t_scene_entry	*load_entry(char *path, uint64_t hash)
+{
+	t_scene_entry	*entry;
+
+	entry = ft_calloc(1, sizeof(*entry));
+	if (!entry)
+		return (NULL);
+	entry->hash = hash;
+	entry->path = ft_strdup(path);
+	entry->data = ft_calloc(1, sizeof(t_data));
+	if (!entry->path || !entry->data || !complete_parsing(path, entry->data))
+		return (free_entry(entry), NULL);
+	entry->camera = entry->data->cam;
+	return (entry);
+}
+
+/*
+** Drops older versions of `path` and anything past SCENE_CACHE_SIZE,
+** keeping the entry just put at the head.
+*/
+static void	evict(t_scene_cache *cache)
+{
+	t_scene_entry	**link;
+	t_scene_entry	*entry;
+	int				kept;
+
+	kept = 1;
+	link = &cache->head->next;
+	while (*link)
+	{
+		entry = *link;
+		if (kept >= SCENE_CACHE_SIZE
+			|| ft_strncmp(entry->path, cache->head->path,
+				ft_strlen(entry->path) + 1) == 0)
+		{
+			*link = entry->next;
+			free_entry(entry);
+			cache->count--;
+			continue ;
+		}
+		kept++;
+		link = &entry->next;
+	}
+}
+
+/*
+** Returns the parsed scene for `path`, reusing a cached one whose content
+** hash matches (textures included, since they hang off its materials).
+** The hit moves to the head of the list so eviction is least recently used.
+*/
+t_scene_entry	*scene_cache_get(t_scene_cache *cache, char *path, bool *hit)
+{
+	t_scene_entry	**link;
+	t_scene_entry	*entry;
+	uint64_t		hash;
+
+	if (!scene_hash(path, &hash))
+		return (printf("❌ %s: cannot read scene\n", path), NULL);
+	link = &cache->head;
+	while (*link && (*link)->hash != hash)
+		link = &(*link)->next;
+	*hit = (*link != NULL);
+	entry = *link;
+	if (entry)
+		*link = entry->next;
+	else
+	{
+		entry = load_entry(path, hash);
+		if (!entry)
+			return (NULL);
+		cache->count++;
+	}
+	entry->next = cache->head;
+	cache->head = entry;
+	evict(cache);
+	return (entry);
+}
+
+void	scene_cache_free(t_scene_cache *cache)
+{
+	t_scene_entry	*next;
+
+	while (cache->head)
+	{
+		next = cache->head->next;
+		free_entry(cache->head);
+		cache->head = next;
+	}
+	cache->count = 0;
+}
@@ -0,0 +1,171 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   server_bonus.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 16:05:47 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 20:11:09 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT_bonus.h"
+#include <signal.h>
+#include <sys/socket.h>
+
+static volatile sig_atomic_t	g_server_stop;
+
+static void	on_stop_signal(int sig)
+{
+	(void)sig;
+	g_server_stop = 1;
+}
+
+/*
+** Points the cached scene at this request's settings: the parsed camera is
+** restored before any override, then setup_world rebuilds the camera and
+** the per-light occluder lists for the new eye. Returns the clipped region.
+*/
+static bool	prepare_scene(t_scene_entry *entry, t_job *job, t_tile *region)
+{
+	t_camera	cam;
+
+	entry->data->opts.job = *job;
+	entry->data->cam = entry->camera;
+	setup_world(entry->data, &cam);
+	return (job_region(job, region));
+}
+
+/*
+** Tiles go back as 8-bit RGB, clamped like the on-screen image, with their
+** position in frame coordinates.
+*/
+static bool	send_tile(int fd, t_render_pool *pool, int index)
+{
+	static uint8_t	rgb[TILE_SIZE * TILE_SIZE * 3];
+	t_tile			tile;
+	float			*src;
+	int				i;
+
+	tile = tile_rect(index, pool->tiles_x, pool->region.w, pool->region.h);
+	i = 0;
+	while (i < tile.w * tile.h * 3)
+	{
+		src = &pool->fb.rgb[((size_t)(tile.y + i / 3 / tile.w)
+				*pool->fb.width + tile.x + i / 3 % tile.w) * 3];
+		rgb[i] = channel_to_byte(src[i % 3]);
+		i++;
+	}
+	tile.x += pool->region.x;
+	tile.y += pool->region.y;
+	return (net_send(fd, MSG_RESULT, NULL, sizeof(tile) + i)
+		&& net_write(fd, &tile, sizeof(tile)) && net_write(fd, rgb, i));
+}
+
+static bool	stream_tiles(int fd, t_render_pool *pool)
+{
+	int	sent;
+	int	count;
+
+	sent = 0;
+	while (sent < pool->total_tiles)
+	{
+		count = pool_collect(pool, sent);
+		while (sent < count)
+		{
+			if (!send_tile(fd, pool, pool->finished[sent++]))
+				return (pool_cancel(pool), false);
+		}
+	}
+	return (true);
+}
+
+static bool	serve_request(int fd, t_scene_cache *cache, t_render_pool *pool,
+		uint32_t size)
+{
+	t_job			job;
+	char			path[4097];
+	t_scene_entry	*entry;
+	t_render_stats	stats;
+	t_tile			region;
+	bool			hit;
+
+	if (size <= sizeof(job) || size - sizeof(job) >= sizeof(path)
+		|| !net_read(fd, &job, sizeof(job))
+		|| !net_read(fd, path, size - sizeof(job)))
+		return (false);
+	path[size - sizeof(job)] = '\0';
+	stats = (t_render_stats){.load_ms = net_clock()};
+	entry = scene_cache_get(cache, path, &hit);
+	stats.cache_hit = hit;
+	if (!entry || job.width <= 0 || job.height <= 0 || job.samples <= 0
+		|| !prepare_scene(entry, &job, &region))
+		return (net_send(fd, MSG_FAIL, NULL, 0));
+	stats.render_ms = net_clock();
+	stats.load_ms = (stats.render_ms - stats.load_ms) * 1000.0f;
+	if (!pool_submit(pool, entry->data, region))
+		return (net_send(fd, MSG_FAIL, NULL, 0));
+	if (!stream_tiles(fd, pool))
+		return (false);
+	stats.render_ms = (net_clock() - stats.render_ms) * 1000.0f;
+	stats.tiles = pool->total_tiles;
+	if (hit)
+		printf("🎞️  %s (cached): ", path);
+	else
+		printf("🎞️  %s (parsed): ", path);
+	printf("%dx%d, load %.1f ms, render %.1f ms\n", region.w, region.h,
+		stats.load_ms, stats.render_ms);
+	fflush(stdout);
+	return (net_send(fd, MSG_DONE, &stats, sizeof(stats)));
+}
+
+static void	serve_client(int fd, t_scene_cache *cache, t_render_pool *pool)
+{
+	t_msg_header	header;
+
+	net_nodelay(fd);
+	while (net_read(fd, &header, sizeof(header)))
+	{
+		if (header.type != MSG_RENDER
+			|| !serve_request(fd, cache, pool, header.size))
+			break ;
+	}
+	close(fd);
+}
+
+/*
+** Render daemon: keeps parsed scenes (and their textures) and a thread pool
+** alive between requests. SIGINT/SIGTERM interrupt accept() (no
+** SA_RESTART) and shut it down cleanly. Clients are served one at a time; each may send
+** any number of MSG_RENDER jobs on its connection and gets the tiles back
+** as they finish, then MSG_DONE with timings (or MSG_FAIL).
+*/
+int	run_server(t_options *opts)
+{
+	t_scene_cache		cache;
+	t_render_pool		pool;
+	struct sigaction	sa;
+	int					listen_fd;
+	int					fd;
+
+	sa = (struct sigaction){.sa_handler = on_stop_signal};
+	sigaction(SIGINT, &sa, NULL);
+	sigaction(SIGTERM, &sa, NULL);
+	cache = (t_scene_cache){};
+	listen_fd = net_listen(opts->serve);
+	if (listen_fd < 0 || !pool_start(&pool, NUM_THREADS))
+		return (1);
+	printf("🛰️  Render server on %s (%d threads)\n", opts->serve,
+		pool.thread_count);
+	while (!g_server_stop)
+	{
+		fd = accept(listen_fd, NULL, NULL);
+		if (fd >= 0)
+			serve_client(fd, &cache, &pool);
+	}
+	close(listen_fd);
+	if (!ft_strchr(opts->serve, ':') || ft_strchr(opts->serve, '/'))
+		unlink(opts->serve);
+	return (pool_stop(&pool), scene_cache_free(&cache), 0);
+}
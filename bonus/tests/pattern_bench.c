@@ -0,0 +1,172 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pattern_bench.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 21:05:00 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 21:05:00 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Check and microbenchmark for the batch pattern path (make
+** bench_patterns). For each pattern, with and without a transform, the
+** same random points go through pattern_color one at a time and through
+** pattern_colors as one run; every colour must match bit for bit, and the
+** time per point of both is printed. Exits 1 on any mismatch.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "miniRT_bonus.h"
+
+#define BENCH_N 4096 // points per run, fits in L1/L2
+#define BENCH_PASSES 2000 // runs per measurement
+
+static t_tuple	g_points[BENCH_N];
+static t_tuple	g_ref[BENCH_N];
+static float	g_soa[7][BENCH_N];
+
+static double	bench_now(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}
+
+/*
+** Mostly random points, with every eighth one on or just off an integer
+** coordinate, where floor and the checkers epsilon decide the colour.
+*/
+static void	fill_points(void)
+{
+	float	v[3];
+	int		i;
+	int		k;
+
+	srand(42);
+	for (i = 0; i < BENCH_N; i++)
+	{
+		for (k = 0; k < 3; k++)
+		{
+			v[k] = (rand() / (float)RAND_MAX - 0.5f) * 40.0f;
+			if (i % 8 == 0)
+				v[k] = (float)(rand() % 41 - 20) - (rand() % 3) * 0.000005f;
+		}
+		g_points[i] = (t_tuple){v[0], v[1], v[2], 1};
+	}
+}
+
+static t_pattern_run	load_run(void)
+{
+	int	i;
+
+	for (i = 0; i < BENCH_N; i++)
+	{
+		g_soa[0][i] = g_points[i].x;
+		g_soa[1][i] = g_points[i].y;
+		g_soa[2][i] = g_points[i].z;
+	}
+	return ((t_pattern_run){g_soa[0], g_soa[1], g_soa[2], g_soa[3],
+		g_soa[4], g_soa[5], g_soa[6], BENCH_N});
+}
+
+static int	mismatches(t_pattern_run *run)
+{
+	int	bad;
+	int	i;
+
+	bad = 0;
+	for (i = 0; i < BENCH_N; i++)
+		if (memcmp(&run->r[i], &g_ref[i].x, sizeof(float))
+			|| memcmp(&run->g[i], &g_ref[i].y, sizeof(float))
+			|| memcmp(&run->b[i], &g_ref[i].z, sizeof(float)))
+			bad++;
+	return (bad);
+}
+
+/*
+** ns per point of the single-point and the batch path; the batch time
+** includes loading the run, as a caller gathering hits would pay that.
+*/
+static int	bench(const char *name, const t_pattern *pattern)
+{
+	t_pattern_run	run;
+	double			t0;
+	double			t_one;
+	double			t_run;
+	int				p;
+	int				i;
+
+	t0 = bench_now();
+	for (p = 0; p < BENCH_PASSES; p++)
+		for (i = 0; i < BENCH_N; i++)
+			g_ref[i] = pattern_color(pattern, g_points[i]);
+	t_one = bench_now() - t0;
+	t0 = bench_now();
+	for (p = 0; p < BENCH_PASSES; p++)
+	{
+		run = load_run();
+		pattern_colors(pattern, &run);
+	}
+	t_run = bench_now() - t0;
+	printf("%-22s %10.2f %10.2f %8d\n", name,
+		t_one * 1e9 / ((double)BENCH_PASSES * BENCH_N),
+		t_run * 1e9 / ((double)BENCH_PASSES * BENCH_N), mismatches(&run));
+	return (mismatches(&run));
+}
+
+/*
+** A rotation about y plus scaling and translation, so every matrix entry
+** the batch transform reads is non-trivial.
+*/
+static t_pattern	with_transform(t_pattern pattern)
+{
+	static const float	m[3][4] = {{0.6f, 0.0f, 0.8f, 1.25f},
+	{0.0f, 2.0f, 0.0f, -0.5f}, {-0.8f, 0.0f, 0.6f, 3.0f}};
+	int					r;
+	int					c;
+
+	for (r = 0; r < 3; r++)
+		for (c = 0; c < 4; c++)
+			pattern.inv_transform.mtrx[r][c] = m[r][c] * 0.7f;
+	pattern.has_transform = true;
+	return (pattern);
+}
+
+int	main(void)
+{
+	t_pattern	(*make[3])(t_tuple, t_tuple);
+	const char	*names[6];
+	t_pattern	pattern;
+	int			bad;
+	int			k;
+
+	make[0] = stripe_patern;
+	make[1] = ring_pattern;
+	make[2] = checkers_pattern;
+	memcpy(names, (const char *[6]){"stripe", "ring", "checkers",
+		"stripe, transformed", "ring, transformed",
+		"checkers, transformed"}, sizeof(names));
+	fill_points();
+	printf("%-22s %10s %10s %8s\n", "pattern (ns/point)", "one", "batch",
+		"differ");
+	bad = 0;
+	for (k = 0; k < 6; k++)
+	{
+		pattern = make[k % 3]((t_tuple){0.9f, 0.2f, 0.1f, 0},
+				(t_tuple){0.1f, 0.4f, 0.8f, 0});
+		if (k >= 3)
+			pattern = with_transform(pattern);
+		bad += bench(names[k], &pattern);
+	}
+	if (bad)
+		return (printf("❌ %d colours differ from pattern_color\n", bad), 1);
+	printf("batch path matches pattern_color on every point\n");
+	return (0);
+}
@@ -0,0 +1,209 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   vector_bench.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 15:54:41 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 15:54:41 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Microbenchmark for the inline tuple library (make bench_vectors).
+** Each operation runs over the same random input twice: once through the
+** static inline version from vector_simd_bonus.h and once through a
+** noinline wrapper, which is what every call cost before the library
+** moved into the header. Build with NO_SIMD=1 to time the scalar path.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "math_ops_bonus.h"
+
+#define BENCH_N 4096 // tuples per pass, fits in L1/L2
+#define BENCH_PASSES 4000 // passes per measurement
+
+#define BENCH_T(out, expr) \
+	do { \
+		double	t0; \
+		int		p; \
+		int		i; \
+		t0 = bench_now(); \
+		for (p = 0; p < BENCH_PASSES; p++) \
+			for (i = 0; i < BENCH_N; i++) \
+				out[i] = expr; \
+		*elapsed = bench_now() - t0; \
+	} while (0)
+
+static t_tuple	g_a[BENCH_N];
+static t_tuple	g_b[BENCH_N];
+static t_tuple	g_out[BENCH_N];
+static float	g_fout[BENCH_N];
+
+static double	bench_now(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}
+
+__attribute__((noinline)) static t_tuple	call_add(t_tuple a, t_tuple b)
+{
+	return (add_tuple(a, b));
+}
+
+__attribute__((noinline)) static t_tuple	call_sub(t_tuple a, t_tuple b)
+{
+	return (substract_tuple(a, b));
+}
+
+__attribute__((noinline)) static t_tuple	call_scale(t_tuple a, float s)
+{
+	return (tuple_scalar_mult(a, s));
+}
+
+__attribute__((noinline)) static t_tuple	call_hadamard(t_tuple a, t_tuple b)
+{
+	return (hadamard_product(a, b));
+}
+
+__attribute__((noinline)) static float	call_dot(t_tuple a, t_tuple b)
+{
+	return (vecs_dot_product(a, b));
+}
+
+__attribute__((noinline)) static t_tuple	call_cross(t_tuple a, t_tuple b)
+{
+	return (vecs_cross_product(a, b));
+}
+
+__attribute__((noinline)) static t_tuple	call_normalize(t_tuple a)
+{
+	return (normalizing_vector(a));
+}
+
+__attribute__((noinline)) static t_tuple	call_normalize_fast(t_tuple a)
+{
+	return (normalizing_vector_fast(a));
+}
+
+__attribute__((noinline)) static t_tuple	call_reflect(t_tuple a, t_tuple b)
+{
+	return (reflect(a, b));
+}
+
+static void	run_inline(int op, double *elapsed)
+{
+	if (op == 0)
+		BENCH_T(g_out, add_tuple(g_a[i], g_b[i]));
+	else if (op == 1)
+		BENCH_T(g_out, substract_tuple(g_a[i], g_b[i]));
+	else if (op == 2)
+		BENCH_T(g_out, tuple_scalar_mult(g_a[i], g_b[i].x));
+	else if (op == 3)
+		BENCH_T(g_out, hadamard_product(g_a[i], g_b[i]));
+	else if (op == 4)
+		BENCH_T(g_fout, vecs_dot_product(g_a[i], g_b[i]));
+	else if (op == 5)
+		BENCH_T(g_out, vecs_cross_product(g_a[i], g_b[i]));
+	else if (op == 6)
+		BENCH_T(g_out, normalizing_vector(g_a[i]));
+	else if (op == 7)
+		BENCH_T(g_out, normalizing_vector_fast(g_a[i]));
+	else
+		BENCH_T(g_out, reflect(g_a[i], g_b[i]));
+}
+
+static void	run_call(int op, double *elapsed)
+{
+	if (op == 0)
+		BENCH_T(g_out, call_add(g_a[i], g_b[i]));
+	else if (op == 1)
+		BENCH_T(g_out, call_sub(g_a[i], g_b[i]));
+	else if (op == 2)
+		BENCH_T(g_out, call_scale(g_a[i], g_b[i].x));
+	else if (op == 3)
+		BENCH_T(g_out, call_hadamard(g_a[i], g_b[i]));
+	else if (op == 4)
+		BENCH_T(g_fout, call_dot(g_a[i], g_b[i]));
+	else if (op == 5)
+		BENCH_T(g_out, call_cross(g_a[i], g_b[i]));
+	else if (op == 6)
+		BENCH_T(g_out, call_normalize(g_a[i]));
+	else if (op == 7)
+		BENCH_T(g_out, call_normalize_fast(g_a[i]));
+	else
+		BENCH_T(g_out, call_reflect(g_a[i], g_b[i]));
+}
+
+/*
+** Worst relative error of the fast normalise against the exact one, so
+** the accuracy cost of rsqrt is printed next to its speed.
+*/
+static float	fast_normalize_error(void)
+{
+	t_tuple	exact;
+	t_tuple	fast;
+	float	worst;
+	float	err;
+	int		i;
+
+	worst = 0;
+	for (i = 0; i < BENCH_N; i++)
+	{
+		exact = normalizing_vector(g_a[i]);
+		fast = normalizing_vector_fast(g_a[i]);
+		err = vector_magnitude(substract_tuple(exact, fast));
+		if (err > worst)
+			worst = err;
+	}
+	return (worst);
+}
+
+int	main(void)
+{
+	static const char	*names[] = {"add_tuple", "substract_tuple",
+		"tuple_scalar_mult", "hadamard_product", "vecs_dot_product",
+		"vecs_cross_product", "normalizing_vector",
+		"normalizing_vector_fast", "reflect"};
+	const char			*mode;
+	double				t_inline;
+	double				t_call;
+	double				sink;
+	int					op;
+	int					i;
+
+	mode = "scalar";
+	if (VEC_SIMD)
+		mode = "SSE";
+	srand(42);
+	for (i = 0; i < BENCH_N; i++)
+	{
+		g_a[i] = (t_tuple){rand() / (float)RAND_MAX - 0.5f,
+			rand() / (float)RAND_MAX - 0.5f,
+			rand() / (float)RAND_MAX - 0.5f, 0};
+		g_b[i] = (t_tuple){rand() / (float)RAND_MAX - 0.5f,
+			rand() / (float)RAND_MAX - 0.5f,
+			rand() / (float)RAND_MAX - 0.5f, 0};
+	}
+	printf("%-24s %10s %10s   (%s, ns/op)\n", "operation", "inline",
+		"call", mode);
+	sink = 0;
+	for (op = 0; op < 9; op++)
+	{
+		run_inline(op, &t_inline);
+		sink += g_out[op].x + g_fout[op];
+		run_call(op, &t_call);
+		sink += g_out[op].x + g_fout[op];
+		printf("%-24s %10.3f %10.3f\n", names[op],
+			t_inline * 1e9 / ((double)BENCH_N * BENCH_PASSES),
+			t_call * 1e9 / ((double)BENCH_N * BENCH_PASSES));
+	}
+	printf("normalizing_vector_fast max error: %.3g (sink %g)\n",
+		fast_normalize_error(), sink);
+	return (0);
+}
@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/01 00:00:00 by amn700            #+#    #+#             */
-/*   Updated: 2026/01/03 12:03:05 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 14:49:44 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -30,6 +30,7 @@
 # include <stdbool.h>
 # include <stdio.h>
 # include <stdlib.h>
+# include <time.h>
 # include <unistd.h>
 
 typedef struct s_data
@@ -39,6 +40,7 @@ typedef struct s_data
 	t_light			*light;
 	t_object		*object;
 	t_world			world;
+	t_options		opts;
 	mlx_t			*ptr;
 	mlx_image_t		*img;
 }					t_data;
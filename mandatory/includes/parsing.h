@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2025/12/07 13:24:58 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 14:42:31 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -20,6 +20,7 @@ typedef struct s_data	t_data;
 void	errors_map(int code);
 bool	check_extension(char *file);
 bool	complete_parsing(char *file, t_data *data);
+bool	parse_options(int argc, char **argv, t_options *opts);
 bool	extract_data(char *file, t_data *data);
 void	apply_ambient_to_objects(t_data *data);
 char	**ft_split_rt(char const *s, char *charset);
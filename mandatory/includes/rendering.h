@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 10:03:18 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 14:35:18 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -16,9 +16,18 @@
 # include "types.h"
 # include "../MLX42/include/MLX42/MLX42.h"
 
-mlx_image_t	*render(mlx_t *mlx, t_camera cam, t_world world);
+// Side of the square tiles render threads pull from the shared counter
+# define TILE_SIZE 32
+// Most render threads --threads accepts
+# define MAX_THREADS 256
+
+mlx_image_t	*render(mlx_t *mlx, t_camera cam, t_world world, int threads);
+bool		render_pixels(t_render *r, int threads);
+double		render_clock(void);
 bool		mlx_image_to_ppm(mlx_image_t *img, char *string,
 				unsigned int range);
+bool		pixels_to_ppm(uint8_t *pixels, int width, int height,
+				char *path);
 int			convert_color(t_tuple c);
 void		execute_raytracing(void);
 
@@ -6,13 +6,14 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 11:30:22 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 14:28:05 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef TYPES_H
 # define TYPES_H
 
+# include <pthread.h>
 # include <stdint.h>
 # include <stdbool.h>
 
@@ -178,4 +179,31 @@ typedef struct s_screen
 	double	y;
 }	t_screen;
 
+/*
+** One frame shared by the render threads: they take TILE_SIZE tiles off
+** next_tile and write RGBA bytes straight into pixels.
+*/
+typedef struct s_render
+{
+	t_world			world;
+	t_camera		cam;
+	uint8_t			*pixels;
+	int				width;
+	int				height;
+	int				tiles_x;
+	int				total_tiles;
+	int				next_tile;
+	int				tiles_done;
+	pthread_mutex_t	mutex;
+}	t_render;
+
+typedef struct s_options
+{
+	char	*scene;
+	char	*output;
+	int		width;
+	int		height;
+	int		threads;
+}	t_options;
+
 #endif
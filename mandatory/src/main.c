@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 10:25:56 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 14:56:57 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -34,7 +34,7 @@ int	initialize_mlx(t_data *data, t_camera cam)
 		printf("❌ Failed to initialize MLX\n");
 		return (0);
 	}
-	data->img = render(data->ptr, cam, data->world);
+	data->img = render(data->ptr, cam, data->world, data->opts.threads);
 	if (!data->img)
 	{
 		printf("❌ Failed to create image\n");
@@ -50,7 +50,8 @@ int	setup_world(t_data *data, t_camera *cam)
 	data->world.objects = data->object;
 	data->world.lights = data->light;
 	data->world.ambient_color = data->ambl.color;
-	*cam = camera(1920, 1080, data->cam.fov * M_PI / 180.0);
+	*cam = camera(data->opts.width, data->opts.height,
+			data->cam.fov * M_PI / 180.0);
 	cam->transform = view_transformation(data->cam.from, data->cam.to,
 			data->cam.up);
 	return (1);
@@ -79,18 +80,55 @@ void	free_objects_and_lights(t_data *data)
 	}
 }
 
+/*
+** --output: render without a window and save the frame as a binary PPM.
+*/
+static int	render_headless(t_data *data, t_camera cam)
+{
+	t_render	r;
+	double		start;
+	bool		ok;
+
+	r = (t_render){.world = data->world, .cam = cam,
+		.width = data->opts.width, .height = data->opts.height};
+	r.pixels = malloc((size_t)r.width * r.height * 4);
+	if (!r.pixels)
+		return (printf("❌ Failed to allocate the image\n"), 1);
+	start = render_clock();
+	ok = render_pixels(&r, data->opts.threads);
+	if (ok)
+		printf("✅ Rendered %dx%d with %d threads in %.3f s\n", r.width,
+			r.height, data->opts.threads, render_clock() - start);
+	if (ok && !pixels_to_ppm(r.pixels, r.width, r.height, data->opts.output))
+	{
+		printf("❌ Error: cannot write %s\n", data->opts.output);
+		ok = false;
+	}
+	else if (ok)
+		printf("💾 Saved %s\n", data->opts.output);
+	free(r.pixels);
+	return (!ok);
+}
+
 int	main(int argc, char **argv)
 {
 	t_data		data;
 	t_camera	cam;
+	int			status;
 
 	data = (t_data){};
-	if (argc != 2)
-		return (printf("❌ Usage: %s <scene_file.rt>\n", argv[0]), 1);
-	if (!complete_parsing(argv[1], &data))
+	if (!parse_options(argc, argv, &data.opts))
+		return (printf("❌ Usage: %s <scene_file.rt> [--threads <n>] "
+				"[--size <w>x<h>] [--output <file.ppm>]\n", argv[0]), 1);
+	if (!complete_parsing(data.opts.scene, &data))
 		return (1);
 	printf("\n✅ Parsing completed successfully!\n");
 	setup_world(&data, &cam);
+	if (data.opts.output)
+	{
+		status = render_headless(&data, cam);
+		return (free_objects_and_lights(&data), status);
+	}
 	printf("\nRendering scene from file...\n");
 	if (!initialize_mlx(&data, cam))
 		return (free_objects_and_lights(&data), 1);
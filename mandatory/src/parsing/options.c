@@ -0,0 +1,104 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:20:52 by amn               #+#    #+#             */
+/*   Updated: 2026/10/19 14:20:52 by amn              ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../includes/miniRT.h"
+
+/*
+** One worker per online CPU unless --threads says otherwise.
+*/
+static void	default_options(t_options *opts)
+{
+	long	cpus;
+
+	opts->scene = NULL;
+	opts->output = NULL;
+	opts->width = 1920;
+	opts->height = 1080;
+	cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	if (cpus < 1)
+		cpus = 1;
+	if (cpus > MAX_THREADS)
+		cpus = MAX_THREADS;
+	opts->threads = (int)cpus;
+}
+
+static bool	parse_count(char *arg, char *flag, int max, int *out)
+{
+	int	i;
+
+	i = 0;
+	while (arg && ft_isdigit(arg[i]))
+		i++;
+	if (!arg || i == 0 || arg[i] || i > 9 || ft_atoi(arg) < 1
+		|| ft_atoi(arg) > max)
+		return (printf("❌ %s: expected an integer in [1, %d]\n", flag, max),
+			false);
+	*out = ft_atoi(arg);
+	return (true);
+}
+
+static bool	parse_size(char *arg, t_options *opts)
+{
+	char	*x;
+	bool	ok;
+
+	x = NULL;
+	if (arg)
+		x = ft_strchr(arg, 'x');
+	if (!x)
+		return (printf("❌ --size: expected <width>x<height>\n"), false);
+	*x = '\0';
+	ok = parse_count(arg, "--size", 16384, &opts->width)
+		&& parse_count(x + 1, "--size", 16384, &opts->height);
+	*x = 'x';
+	return (ok);
+}
+
+static bool	parse_flag(char **argv, int *i, t_options *opts)
+{
+	if (ft_strncmp(argv[*i], "--threads", 10) == 0)
+		return (parse_count(argv[++(*i)], "--threads", MAX_THREADS,
+				&opts->threads));
+	if (ft_strncmp(argv[*i], "--size", 7) == 0)
+		return (parse_size(argv[++(*i)], opts));
+	if (ft_strncmp(argv[*i], "--output", 9) == 0)
+		return (opts->output = argv[++(*i)], opts->output != NULL);
+	return (printf("❌ Unknown argument '%s'\n", argv[*i]), false);
+}
+
+/*
+** Command line: <scene.rt> followed by optional flags.
+**   --threads <n>      render threads (one per online CPU)
+**   --size <w>x<h>     render resolution (1920x1080)
+**   --output <file>    render without a window and write a binary PPM
+*/
+bool	parse_options(int argc, char **argv, t_options *opts)
+{
+	int	i;
+
+	default_options(opts);
+	i = 1;
+	while (i < argc)
+	{
+		if (argv[i][0] == '-')
+		{
+			if (!parse_flag(argv, &i, opts))
+				return (false);
+		}
+		else if (opts->scene)
+			return (printf("❌ Unknown argument '%s'\n", argv[i]), false);
+		else
+			opts->scene = argv[i];
+		i++;
+	}
+	return (opts->scene != NULL);
+}
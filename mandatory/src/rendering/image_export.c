@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/01/03 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 10:25:56 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 15:18:36 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -49,3 +49,27 @@ bool	mlx_image_to_ppm(mlx_image_t *img, char *string, unsigned int range)
 	fclose(output);
 	return (true);
 }
+
+/*
+** width x height RGBA bytes as a binary PPM (P6), for --output.
+*/
+bool	pixels_to_ppm(uint8_t *pixels, int width, int height, char *path)
+{
+	FILE	*output;
+	size_t	i;
+	size_t	count;
+
+	output = fopen(path, "wb");
+	if (!output)
+		return (false);
+	fprintf(output, "P6\n%d %d\n255\n", width, height);
+	count = (size_t)width * height;
+	i = 0;
+	while (i < count)
+	{
+		if (fwrite(pixels + i * 4, 1, 3, output) != 3)
+			return (fclose(output), false);
+		i++;
+	}
+	return (fclose(output) == 0);
+}
@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/12/02 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 11:54:58 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 15:04:10 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,53 +15,110 @@
 void		print_progress_bar(int current, int total, int bar_width);
 uint32_t	tuple_to_pixel(t_tuple color);
 
-static void	render_pixel(mlx_image_t *img, t_camera cam,
-		t_world world, int *coords)
+/*
+** Traces one TILE_SIZE tile, writing RGBA bytes the way mlx_put_pixel
+** does.
+*/
+static void	render_tile(t_render *r, int index)
 {
-	t_ray		ray;
-	t_tuple		color;
-	uint32_t	pixel_color;
+	int			xy[2];
+	int			start[2];
+	uint32_t	color;
+	uint8_t		*pixel;
 
-	ray = ray_for_pixel(cam, (double)coords[0], (double)coords[1]);
-	color = color_at(world, ray);
-	pixel_color = tuple_to_pixel(color);
-	mlx_put_pixel(img, coords[0], coords[1], pixel_color);
+	start[0] = (index % r->tiles_x) * TILE_SIZE;
+	start[1] = (index / r->tiles_x) * TILE_SIZE;
+	xy[1] = start[1];
+	while (xy[1] < start[1] + TILE_SIZE && xy[1] < r->height)
+	{
+		xy[0] = start[0];
+		while (xy[0] < start[0] + TILE_SIZE && xy[0] < r->width)
+		{
+			color = tuple_to_pixel(color_at(r->world, ray_for_pixel(r->cam,
+							(double)xy[0], (double)xy[1])));
+			pixel = r->pixels + ((size_t)xy[1] * r->width + xy[0]) * 4;
+			pixel[0] = (uint8_t)(color >> 24);
+			pixel[1] = (uint8_t)(color >> 16);
+			pixel[2] = (uint8_t)(color >> 8);
+			pixel[3] = (uint8_t)color;
+			xy[0]++;
+		}
+		xy[1]++;
+	}
 }
 
-static void	render_loop(mlx_image_t *img, t_camera cam,
-		t_world world, int *coords)
+/*
+** Takes tiles off the shared counter until none are left. Whoever
+** finishes a tile that moves the percentage redraws the progress bar.
+*/
+static void	*render_worker(void *arg)
 {
-	coords[1] = 0;
-	while (coords[1] < (int)cam.v_view)
+	t_render	*r;
+	int			index;
+
+	r = (t_render *)arg;
+	while (1)
 	{
-		coords[0] = 0;
-		while (coords[0] < (int)cam.h_view)
-		{
-			render_pixel(img, cam, world, coords);
-			coords[3]++;
-			if ((coords[3] * 100) / coords[2]
-				!= ((coords[3] - 1) * 100) / coords[2])
-				print_progress_bar(coords[3], coords[2], 50);
-			coords[0]++;
-		}
-		coords[1]++;
+		pthread_mutex_lock(&r->mutex);
+		index = r->next_tile++;
+		pthread_mutex_unlock(&r->mutex);
+		if (index >= r->total_tiles)
+			return (NULL);
+		render_tile(r, index);
+		pthread_mutex_lock(&r->mutex);
+		r->tiles_done++;
+		if ((r->tiles_done * 100) / r->total_tiles
+			!= ((r->tiles_done - 1) * 100) / r->total_tiles)
+			print_progress_bar(r->tiles_done, r->total_tiles, 50);
+		pthread_mutex_unlock(&r->mutex);
 	}
 }
 
-mlx_image_t	*render(mlx_t *mlx, t_camera cam, t_world world)
+/*
+** Fills r->pixels (width x height RGBA) using `threads` threads. If none
+** can be started the calling thread renders the frame by itself.
+*/
+bool	render_pixels(t_render *r, int threads)
+{
+	pthread_t	*ids;
+	int			started;
+
+	r->tiles_x = (r->width + TILE_SIZE - 1) / TILE_SIZE;
+	r->total_tiles = r->tiles_x * ((r->height + TILE_SIZE - 1) / TILE_SIZE);
+	r->next_tile = 0;
+	r->tiles_done = 0;
+	ids = malloc(sizeof(pthread_t) * threads);
+	if (!ids)
+		return (false);
+	pthread_mutex_init(&r->mutex, NULL);
+	started = 0;
+	while (started < threads
+		&& pthread_create(&ids[started], NULL, render_worker, r) == 0)
+		started++;
+	if (started == 0)
+		render_worker(r);
+	while (started > 0)
+		pthread_join(ids[--started], NULL);
+	pthread_mutex_destroy(&r->mutex);
+	free(ids);
+	return (true);
+}
+
+mlx_image_t	*render(mlx_t *mlx, t_camera cam, t_world world, int threads)
 {
 	mlx_image_t	*img;
-	int			coords[4];
+	t_render	r;
 
 	if (!mlx)
 		return (NULL);
 	img = mlx_new_image(mlx, (int)cam.h_view, (int)cam.v_view);
 	if (!img)
 		return (NULL);
-	coords[2] = (int)cam.h_view * (int)cam.v_view;
-	coords[3] = 0;
+	r = (t_render){.world = world, .cam = cam, .pixels = img->pixels,
+		.width = (int)cam.h_view, .height = (int)cam.v_view};
 	write(1, "\n", 1);
-	render_loop(img, cam, world, coords);
+	if (!render_pixels(&r, threads))
+		return (mlx_delete_image(mlx, img), NULL);
 	write(1, "\n", 1);
 	return (img);
 }
@@ -6,7 +6,7 @@
 /*   By: amn <amn@student.42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2026/01/03 00:00:00 by amn               #+#    #+#             */
-/*   Updated: 2026/01/03 00:00:00 by amn              ###   ########.fr       */
+/*   Updated: 2026/10/19 15:11:23 by amn              ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -68,3 +68,11 @@ uint32_t	tuple_to_pixel(t_tuple color)
 	pixel_color = (r << 24) | (g << 16) | (b << 8) | 0xFF;
 	return (pixel_color);
 }
+
+double	render_clock(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}